@@ -124,7 +124,7 @@ void* default_alloc::allocate(size_t n) {
     obj* volatile* my_free_list = free_list + freelist_index(n);
     obj* result = *my_free_list;
     if (result == 0)
-        return refill(n);
+        return refill(round_up(n));
     *my_free_list = (*my_free_list)->next;
     return static_cast<void*>(result);
 }
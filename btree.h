@@ -0,0 +1,898 @@
+#if !defined(MYSTL_BTREE_H_)
+#define MYSTL_BTREE_H_
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include "memory.h"
+
+/* 本头文件实现了 B+ 树 btree，接口与 rb_tree 相同，可以作为 set 的底层容器
+ * 元素只存放在叶节点中并按顺序连续排列，叶节点之间用双向链表串起来供迭代器遍历；
+ * 内部节点只保存分隔键与孩子指针，节点大小约为 4 个缓存行，
+ * 一次查找只需访问 O(log_B n) 个节点，远少于红黑树逐个节点的指针跳转
+ * 注意：插入与删除会在节点间移动元素，因此会使所有迭代器失效
+ * 移动元素与复制分隔键的中途无法回滚，要求元素与键的复制构造函数不抛出异常，
+ * 移动构造函数不抛出异常（如 std::string）时移动元素改用移动构造 */
+namespace mystl {
+
+// 节点的目标大小（字节），每个节点的容量至少为 4
+const size_t btree_node_bytes = 256;
+
+inline constexpr size_t btree_node_capacity(size_t header, size_t sz) {
+    return (btree_node_bytes - header) / sz < 4 ? 4
+                                                : (btree_node_bytes - header) / sz;
+}
+
+struct btree_node_base {
+    btree_node_base* parent;
+    size_t count;  // 叶节点为元素个数，内部节点为键的个数
+    bool leaf;
+};
+
+template <typename Value>
+struct btree_leaf_node : public btree_node_base {
+    static constexpr size_t capacity = btree_node_capacity(
+        sizeof(btree_node_base) + 2 * sizeof(void*), sizeof(Value));
+
+    btree_leaf_node<Value>* prev;
+    btree_leaf_node<Value>* next;
+    typename std::aligned_storage<sizeof(Value), alignof(Value)>::type
+        storage[capacity];
+
+    Value* data() { return reinterpret_cast<Value*>(storage); }
+};
+
+// 孩子 i 中的键都不大于 keys[i]，孩子 i + 1 中的键都不小于 keys[i]
+// 多留出一个键和一个孩子的位置，插入后再分裂
+template <typename Key>
+struct btree_inner_node : public btree_node_base {
+    static constexpr size_t capacity = btree_node_capacity(
+        sizeof(btree_node_base) + 2 * sizeof(void*),
+        sizeof(Key) + sizeof(void*));
+
+    typename std::aligned_storage<sizeof(Key), alignof(Key)>::type
+        storage[capacity + 1];
+    btree_node_base* children[capacity + 2];
+
+    Key* keys() { return reinterpret_cast<Key*>(storage); }
+};
+
+template <typename Value, typename Ref, typename Ptr>
+struct btree_iterator {
+    using iterator          = btree_iterator<Value, Value&, Value*>;
+    using const_iterator    = btree_iterator<Value, const Value&, const Value*>;
+    using self              = btree_iterator<Value, Ref, Ptr>;
+
+    using iterator_category = bidirectional_iterator_tag;
+    using value_type        = Value;
+    using pointer           = Ptr;
+    using reference         = Ref;
+    using difference_type   = ptrdiff_t;
+    using size_type         = size_t;
+
+    using link_type         = btree_leaf_node<Value>*;
+
+    // 所在叶节点以及在节点内的下标，end() 为最右叶节点的 count 位置
+    link_type node;
+    size_type index;
+
+    btree_iterator(link_type x, size_type i) : node(x), index(i) {}
+    btree_iterator() {}
+    template <typename Iter, typename = typename std::enable_if<
+                                 std::is_same<Iter, iterator>::value>::type>
+    btree_iterator(const Iter& x) : node(x.node), index(x.index) {}
+
+    bool operator==(const self& rhs) const {
+        return node == rhs.node && index == rhs.index;
+    }
+    bool operator!=(const self& rhs) const { return !(*this == rhs); }
+    reference operator*() const { return node->data()[index]; }
+    pointer operator->() const { return &(operator*()); }
+    self& operator++() {
+        if (++index == node->count && node->next) {
+            node = node->next;
+            index = 0;
+        }
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator--() {
+        if (index == 0) {
+            node = node->prev;
+            index = node->count;
+        }
+        --index;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+};  // end struct btree_iterator
+
+// 元素连续存放在叶节点中，没有独立的节点可以交出
+// 因此 btree 的节点句柄直接保存被取出的元素，以便与 rb_tree 的接口保持一致
+template <typename Value>
+class btree_node_handle {
+   public:
+    using value_type = Value;
+
+    btree_node_handle() : engaged(false) {}
+    explicit btree_node_handle(const Value& value) : engaged(false) {
+        mystl::construct(ptr(), value);
+        engaged = true;
+    }
+    btree_node_handle(btree_node_handle&& rhs) : engaged(false) {
+        if (rhs.engaged) {
+            mystl::construct(ptr(), *rhs.ptr());
+            engaged = true;
+            rhs.reset();
+        }
+    }
+    btree_node_handle& operator=(btree_node_handle&& rhs) {
+        if (this != &rhs) {
+            reset();
+            if (rhs.engaged) {
+                mystl::construct(ptr(), *rhs.ptr());
+                engaged = true;
+                rhs.reset();
+            }
+        }
+        return *this;
+    }
+    btree_node_handle(const btree_node_handle&) = delete;
+    btree_node_handle& operator=(const btree_node_handle&) = delete;
+    ~btree_node_handle() { reset(); }
+
+    bool empty() const noexcept { return !engaged; }
+    explicit operator bool() const noexcept { return engaged; }
+    value_type& value() const { return *ptr(); }
+    void reset() {
+        if (engaged) {
+            mystl::destroy(ptr());
+            engaged = false;
+        }
+    }
+
+   private:
+    Value* ptr() const {
+        return reinterpret_cast<Value*>(const_cast<storage_type*>(&storage));
+    }
+
+    using storage_type =
+        typename std::aligned_storage<sizeof(Value), alignof(Value)>::type;
+    storage_type storage;
+    bool engaged;
+};
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+class btree {
+   public:
+    using key_type          = Key;
+    using value_type        = Value;
+    using pointer           = value_type*;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    using const_pointer     = const value_type*;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+    using iterator          = btree_iterator<Value, Value&, Value*>;
+    using const_iterator    = btree_iterator<Value, const Value&, const Value*>;
+    using node_type         = btree_node_handle<Value>;
+
+   protected:
+    using base_ptr      = btree_node_base*;
+    using leaf_type     = btree_leaf_node<Value>;
+    using inner_type    = btree_inner_node<Key>;
+    using leaf_ptr      = leaf_type*;
+    using inner_ptr     = inner_type*;
+    using leaf_alloc    = alloc<leaf_type>;
+    using inner_alloc   = alloc<inner_type>;
+
+    static constexpr size_type leaf_capacity = leaf_type::capacity;
+    static constexpr size_type inner_capacity = inner_type::capacity;
+    // 非根节点至少半满，删除后低于该值则向兄弟借或与兄弟合并
+    static constexpr size_type leaf_min = leaf_capacity / 2;
+    static constexpr size_type inner_min = inner_capacity / 2;
+
+    base_ptr root;
+    leaf_ptr leftmost;
+    leaf_ptr rightmost;
+    size_type node_count;
+    Compare key_compare;
+
+    static const Key& key(const Value& value) { return KeyOfValue()(value); }
+    static leaf_ptr as_leaf(base_ptr x) { return static_cast<leaf_ptr>(x); }
+    static inner_ptr as_inner(base_ptr x) { return static_cast<inner_ptr>(x); }
+
+    leaf_ptr create_leaf();
+    inner_ptr create_inner();
+    void destroy_leaf(leaf_ptr x);
+    void destroy_inner(inner_ptr x);
+    void erase_aux(base_ptr x);
+    void init() {
+        root = leftmost = rightmost = create_leaf();
+        node_count = 0;
+    }
+    template <typename T>
+    static void relocate(T* dst, T* src, size_type n);
+    static size_type child_index(inner_ptr p, base_ptr x);
+    static void remove_child(inner_ptr p, size_type j);
+
+    // 在节点内二分查找
+    size_type leaf_lower(leaf_ptr x, const Key& k) const;
+    size_type leaf_upper(leaf_ptr x, const Key& k) const;
+    leaf_ptr descend_lower(const Key& k) const;
+    leaf_ptr descend_upper(const Key& k) const;
+    iterator normalize(leaf_ptr x, size_type i) const {
+        return i == x->count && x->next ? iterator(x->next, 0)
+                                        : iterator(x, i);
+    }
+    // 修改操作接受 const_iterator，与 std 容器一致，内部再转换为 iterator
+    static iterator to_iterator(const_iterator x) {
+        return iterator(x.node, x.index);
+    }
+
+    iterator insert_in_leaf(leaf_ptr x, size_type i, const Value& value);
+    void insert_in_parent(base_ptr left, const Key& k, base_ptr right);
+    void split_inner(inner_ptr x);
+    iterator erase_at(iterator position);
+    iterator rebalance_leaf(leaf_ptr x, size_type i);
+    void rebalance_inner(inner_ptr x);
+    void merge_leaf(leaf_ptr l, leaf_ptr r, inner_ptr p, size_type j);
+    void merge_inner(inner_ptr l, inner_ptr r, inner_ptr p, size_type j);
+    bool verify_aux(base_ptr x, const Key* lo, const Key* hi, size_type depth,
+                    size_type& leaf_depth, size_type& n) const;
+
+   public:
+    btree(const Compare& comp = Compare()) : key_compare(comp) { init(); }
+    btree(const btree<Key, Value, KeyOfValue, Compare>& x)
+        : key_compare(x.key_compare) {
+        init();
+        try {
+            for (const_iterator it = x.begin(); it != x.end(); ++it)
+                insert_in_leaf(rightmost, rightmost->count, *it);
+        } catch (...) {
+            erase_aux(root);
+            throw;
+        }
+    }
+    btree<Key, Value, KeyOfValue, Compare>& operator=(
+        const btree<Key, Value, KeyOfValue, Compare>& x) {
+        if (this != &x) {
+            btree<Key, Value, KeyOfValue, Compare> tmp(x);
+            swap(tmp);
+        }
+        return *this;
+    }
+    ~btree() { erase_aux(root); }
+
+    Compare key_comp() const { return key_compare; }
+    iterator begin() { return iterator(leftmost, 0); }
+    const_iterator begin() const { return const_iterator(leftmost, 0); }
+    iterator end() { return iterator(rightmost, rightmost->count); }
+    const_iterator end() const {
+        return const_iterator(rightmost, rightmost->count);
+    }
+    bool empty() const { return node_count == 0; }
+    size_type size() const { return node_count; }
+    size_type max_size() const { return size_type(-1); }
+
+    void swap(btree<Key, Value, KeyOfValue, Compare>& rhs) {
+        std::swap(root, rhs.root);
+        std::swap(leftmost, rhs.leftmost);
+        std::swap(rightmost, rhs.rightmost);
+        std::swap(node_count, rhs.node_count);
+        std::swap(key_compare, rhs.key_compare);
+    }
+
+    std::pair<iterator, bool> insert_unique(const value_type& value);
+    iterator insert_equal(const value_type& value);
+    // 只利用插入到末尾的提示，其余情况与不带提示的版本相同
+    iterator insert_unique(const_iterator position, const value_type& value);
+    iterator insert_equal(const_iterator position, const value_type& value);
+
+    template <typename InputIterator>
+    void insert_unique(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert_unique(end(), *first);
+    }
+    template <typename InputIterator>
+    void insert_equal(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert_equal(end(), *first);
+    }
+
+    node_type extract(const_iterator position) {
+        node_type nh(*position);
+        erase(position);
+        return nh;
+    }
+    node_type extract(const key_type& x) {
+        iterator position = find(x);
+        return position == end() ? node_type() : extract(position);
+    }
+    std::pair<iterator, bool> insert_unique(node_type&& nh) {
+        if (nh.empty())
+            return std::pair<iterator, bool>(end(), false);
+        std::pair<iterator, bool> result = insert_unique(nh.value());
+        if (result.second)
+            nh.reset();
+        return result;
+    }
+    iterator insert_equal(node_type&& nh) {
+        if (nh.empty())
+            return end();
+        iterator result = insert_equal(nh.value());
+        nh.reset();
+        return result;
+    }
+
+    void erase(const_iterator position) { erase_at(to_iterator(position)); }
+    size_type erase(const key_type& x);
+    void erase(const_iterator first, const_iterator last);
+    void clear() {
+        erase_aux(root);
+        init();
+    }
+
+    iterator find(const key_type& x);
+    const_iterator find(const key_type& x) const {
+        return const_cast<btree*>(this)->find(x);
+    }
+    size_type count(const key_type& x) const;
+    iterator lower_bound(const key_type& x) {
+        leaf_ptr leaf = descend_lower(x);
+        return normalize(leaf, leaf_lower(leaf, x));
+    }
+    const_iterator lower_bound(const key_type& x) const {
+        return const_cast<btree*>(this)->lower_bound(x);
+    }
+    iterator upper_bound(const key_type& x) {
+        leaf_ptr leaf = descend_upper(x);
+        return normalize(leaf, leaf_upper(leaf, x));
+    }
+    const_iterator upper_bound(const key_type& x) const {
+        return const_cast<btree*>(this)->upper_bound(x);
+    }
+    std::pair<iterator, iterator> equal_range(const key_type& x) {
+        return std::pair<iterator, iterator>(lower_bound(x), upper_bound(x));
+    }
+    std::pair<const_iterator, const_iterator> equal_range(
+        const key_type& x) const {
+        return std::pair<const_iterator, const_iterator>(lower_bound(x),
+                                                         upper_bound(x));
+    }
+    bool verify() const;
+};  // class btree
+
+/* btree 内部辅助函数的实现 */
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::leaf_ptr
+btree<Key, Value, KeyOfValue, Compare>::create_leaf() {
+    leaf_ptr x = leaf_alloc::allocate();
+    x->parent = 0;
+    x->count = 0;
+    x->leaf = true;
+    x->prev = 0;
+    x->next = 0;
+    return x;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::inner_ptr
+btree<Key, Value, KeyOfValue, Compare>::create_inner() {
+    inner_ptr x = inner_alloc::allocate();
+    x->parent = 0;
+    x->count = 0;
+    x->leaf = false;
+    return x;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void btree<Key, Value, KeyOfValue, Compare>::destroy_leaf(leaf_ptr x) {
+    mystl::destroy(x->data(), x->data() + x->count);
+    leaf_alloc::deallocate(x);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void btree<Key, Value, KeyOfValue, Compare>::destroy_inner(inner_ptr x) {
+    mystl::destroy(x->keys(), x->keys() + x->count);
+    inner_alloc::deallocate(x);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void btree<Key, Value, KeyOfValue, Compare>::erase_aux(base_ptr x) {
+    if (x->leaf) {
+        destroy_leaf(as_leaf(x));
+        return;
+    }
+    inner_ptr y = as_inner(x);
+    for (size_type i = 0; i <= y->count; ++i)
+        erase_aux(y->children[i]);
+    destroy_inner(y);
+}
+
+// 把 [src, src + n) 搬到 dst 开始的未初始化空间，两段可以重叠
+// 中途抛出异常时节点内会留下空洞，因此要求 T 的移动或复制构造不抛出异常
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+template <typename T>
+void btree<Key, Value, KeyOfValue, Compare>::relocate(T* dst,
+                                                      T* src,
+                                                      size_type n) {
+    if (dst < src) {
+        for (size_type i = 0; i != n; ++i) {
+            new (dst + i) T(std::move_if_noexcept(src[i]));
+            mystl::destroy(src + i);
+        }
+    } else {
+        for (size_type i = n; i != 0; --i) {
+            new (dst + i - 1) T(std::move_if_noexcept(src[i - 1]));
+            mystl::destroy(src + i - 1);
+        }
+    }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::size_type
+btree<Key, Value, KeyOfValue, Compare>::child_index(inner_ptr p, base_ptr x) {
+    size_type j = 0;
+    while (p->children[j] != x)
+        ++j;
+    return j;
+}
+
+// 删除 p 的第 j 个键以及它右侧的孩子
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void btree<Key, Value, KeyOfValue, Compare>::remove_child(inner_ptr p,
+                                                          size_type j) {
+    mystl::destroy(p->keys() + j);
+    relocate(p->keys() + j, p->keys() + j + 1, p->count - j - 1);
+    for (size_type c = j + 1; c != p->count; ++c)
+        p->children[c] = p->children[c + 1];
+    --p->count;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::size_type
+btree<Key, Value, KeyOfValue, Compare>::leaf_lower(leaf_ptr x,
+                                                   const Key& k) const {
+    const Compare& comp = key_compare;
+    return std::lower_bound(x->data(), x->data() + x->count, k,
+                            [&comp](const Value& v, const Key& x) {
+                                return comp(key(v), x);
+                            }) -
+           x->data();
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::size_type
+btree<Key, Value, KeyOfValue, Compare>::leaf_upper(leaf_ptr x,
+                                                   const Key& k) const {
+    const Compare& comp = key_compare;
+    return std::upper_bound(x->data(), x->data() + x->count, k,
+                            [&comp](const Key& x, const Value& v) {
+                                return comp(x, key(v));
+                            }) -
+           x->data();
+}
+
+// 沿第一个不小于 k 的分隔键向下，到达的叶节点之前的元素都小于 k
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::leaf_ptr
+btree<Key, Value, KeyOfValue, Compare>::descend_lower(const Key& k) const {
+    base_ptr x = root;
+    while (!x->leaf) {
+        inner_ptr y = as_inner(x);
+        x = y->children[std::lower_bound(y->keys(), y->keys() + y->count, k,
+                                         key_compare) -
+                        y->keys()];
+    }
+    return as_leaf(x);
+}
+
+// 沿第一个大于 k 的分隔键向下，到达的叶节点之后的元素都大于 k
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::leaf_ptr
+btree<Key, Value, KeyOfValue, Compare>::descend_upper(const Key& k) const {
+    base_ptr x = root;
+    while (!x->leaf) {
+        inner_ptr y = as_inner(x);
+        x = y->children[std::upper_bound(y->keys(), y->keys() + y->count, k,
+                                         key_compare) -
+                        y->keys()];
+    }
+    return as_leaf(x);
+}
+
+// 在叶节点 x 的第 i 个位置插入，叶节点已满时先对半分裂
+// 复制 value 时树已经被修改，依赖文件开头要求的复制构造不抛出异常
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::iterator
+btree<Key, Value, KeyOfValue, Compare>::insert_in_leaf(leaf_ptr x,
+                                                       size_type i,
+                                                       const Value& value) {
+    leaf_ptr right = 0;
+    if (x->count == leaf_capacity) {
+        right = create_leaf();
+        size_type mid = leaf_capacity / 2;
+        relocate(right->data(), x->data() + mid, leaf_capacity - mid);
+        right->count = leaf_capacity - mid;
+        x->count = mid;
+        right->next = x->next;
+        right->prev = x;
+        if (x->next)
+            x->next->prev = right;
+        else
+            rightmost = right;
+        x->next = right;
+        if (i > mid) {
+            x = right;
+            i -= mid;
+        }
+    }
+    relocate(x->data() + i + 1, x->data() + i, x->count - i);
+    mystl::construct(x->data() + i, value);
+    ++x->count;
+    ++node_count;
+    if (right)
+        insert_in_parent(right->prev, key(right->data()[0]), right);
+    return iterator(x, i);
+}
+
+// 分裂后把分隔键 k 与新节点 right 插入到 left 的父节点中
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void btree<Key, Value, KeyOfValue, Compare>::insert_in_parent(base_ptr left,
+                                                              const Key& k,
+                                                              base_ptr right) {
+    if (left->parent == 0) {
+        inner_ptr r = create_inner();
+        mystl::construct(r->keys(), k);
+        r->children[0] = left;
+        r->children[1] = right;
+        r->count = 1;
+        left->parent = right->parent = r;
+        root = r;
+        return;
+    }
+    inner_ptr p = as_inner(left->parent);
+    size_type j = child_index(p, left);
+    relocate(p->keys() + j + 1, p->keys() + j, p->count - j);
+    mystl::construct(p->keys() + j, k);
+    for (size_type c = p->count + 1; c != j + 1; --c)
+        p->children[c] = p->children[c - 1];
+    p->children[j + 1] = right;
+    right->parent = p;
+    if (++p->count > inner_capacity)
+        split_inner(p);
+}
+
+// 中间的键上移到父节点，右半部分移入新节点
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void btree<Key, Value, KeyOfValue, Compare>::split_inner(inner_ptr x) {
+    inner_ptr y = create_inner();
+    size_type mid = x->count / 2;
+    relocate(y->keys(), x->keys() + mid + 1, x->count - mid - 1);
+    y->count = x->count - mid - 1;
+    for (size_type c = 0; c <= y->count; ++c) {
+        y->children[c] = x->children[mid + 1 + c];
+        y->children[c]->parent = y;
+    }
+    Key up(x->keys()[mid]);
+    mystl::destroy(x->keys() + mid);
+    x->count = mid;
+    insert_in_parent(x, up, y);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::iterator
+btree<Key, Value, KeyOfValue, Compare>::erase_at(iterator position) {
+    leaf_ptr x = position.node;
+    size_type i = position.index;
+    mystl::destroy(x->data() + i);
+    relocate(x->data() + i, x->data() + i + 1, x->count - i - 1);
+    --x->count;
+    --node_count;
+    return rebalance_leaf(x, i);
+}
+
+// 叶节点过空时向兄弟借一个元素或与兄弟合并
+// 返回原先位于 (x, i) 处的元素（即被删元素的后继）调整后的位置
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::iterator
+btree<Key, Value, KeyOfValue, Compare>::rebalance_leaf(leaf_ptr x,
+                                                       size_type i) {
+    if (x->parent == 0 || x->count >= leaf_min)
+        return normalize(x, i);
+    inner_ptr p = as_inner(x->parent);
+    size_type j = child_index(p, x);
+    if (j < p->count) {
+        leaf_ptr r = as_leaf(p->children[j + 1]);
+        if (x->count + r->count <= leaf_capacity) {
+            merge_leaf(x, r, p, j);
+            rebalance_inner(p);
+            return normalize(x, i);
+        }
+        mystl::construct(x->data() + x->count, r->data()[0]);
+        ++x->count;
+        mystl::destroy(r->data());
+        relocate(r->data(), r->data() + 1, r->count - 1);
+        --r->count;
+        p->keys()[j] = key(r->data()[0]);
+        return normalize(x, i);
+    }
+    leaf_ptr l = as_leaf(p->children[j - 1]);
+    if (l->count + x->count <= leaf_capacity) {
+        size_type offset = l->count;
+        merge_leaf(l, x, p, j - 1);
+        rebalance_inner(p);
+        return normalize(l, offset + i);
+    }
+    relocate(x->data() + 1, x->data(), x->count);
+    mystl::construct(x->data(), l->data()[l->count - 1]);
+    mystl::destroy(l->data() + l->count - 1);
+    --l->count;
+    ++x->count;
+    p->keys()[j - 1] = key(x->data()[0]);
+    return normalize(x, i + 1);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void btree<Key, Value, KeyOfValue, Compare>::rebalance_inner(inner_ptr x) {
+    if (x->parent == 0) {
+        // 根节点只剩一个孩子时树高减一
+        if (x->count == 0) {
+            root = x->children[0];
+            root->parent = 0;
+            destroy_inner(x);
+        }
+        return;
+    }
+    if (x->count >= inner_min)
+        return;
+    inner_ptr p = as_inner(x->parent);
+    size_type j = child_index(p, x);
+    if (j < p->count) {
+        inner_ptr r = as_inner(p->children[j + 1]);
+        if (x->count + r->count + 1 <= inner_capacity) {
+            merge_inner(x, r, p, j);
+            rebalance_inner(p);
+            return;
+        }
+        // 父节点的分隔键下移到 x 末尾，r 的第一个键上移
+        mystl::construct(x->keys() + x->count, p->keys()[j]);
+        x->children[x->count + 1] = r->children[0];
+        r->children[0]->parent = x;
+        ++x->count;
+        p->keys()[j] = r->keys()[0];
+        mystl::destroy(r->keys());
+        relocate(r->keys(), r->keys() + 1, r->count - 1);
+        for (size_type c = 0; c != r->count; ++c)
+            r->children[c] = r->children[c + 1];
+        --r->count;
+        return;
+    }
+    inner_ptr l = as_inner(p->children[j - 1]);
+    if (l->count + x->count + 1 <= inner_capacity) {
+        merge_inner(l, x, p, j - 1);
+        rebalance_inner(p);
+        return;
+    }
+    // 父节点的分隔键下移到 x 开头，l 的最后一个键上移
+    relocate(x->keys() + 1, x->keys(), x->count);
+    for (size_type c = x->count + 1; c != 0; --c)
+        x->children[c] = x->children[c - 1];
+    mystl::construct(x->keys(), p->keys()[j - 1]);
+    x->children[0] = l->children[l->count];
+    x->children[0]->parent = x;
+    ++x->count;
+    p->keys()[j - 1] = l->keys()[l->count - 1];
+    mystl::destroy(l->keys() + l->count - 1);
+    --l->count;
+}
+
+// 把 r 并入其左兄弟 l，并从父节点中删除两者间的分隔键
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void btree<Key, Value, KeyOfValue, Compare>::merge_leaf(leaf_ptr l,
+                                                        leaf_ptr r,
+                                                        inner_ptr p,
+                                                        size_type j) {
+    relocate(l->data() + l->count, r->data(), r->count);
+    l->count += r->count;
+    r->count = 0;
+    l->next = r->next;
+    if (r->next)
+        r->next->prev = l;
+    else
+        rightmost = l;
+    destroy_leaf(r);
+    remove_child(p, j);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void btree<Key, Value, KeyOfValue, Compare>::merge_inner(inner_ptr l,
+                                                         inner_ptr r,
+                                                         inner_ptr p,
+                                                         size_type j) {
+    mystl::construct(l->keys() + l->count, p->keys()[j]);
+    relocate(l->keys() + l->count + 1, r->keys(), r->count);
+    for (size_type c = 0; c <= r->count; ++c) {
+        l->children[l->count + 1 + c] = r->children[c];
+        r->children[c]->parent = l;
+    }
+    l->count += r->count + 1;
+    r->count = 0;
+    destroy_inner(r);
+    remove_child(p, j);
+}
+
+/* btree 公开成员函数的实现 */
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+std::pair<typename btree<Key, Value, KeyOfValue, Compare>::iterator, bool>
+btree<Key, Value, KeyOfValue, Compare>::insert_unique(const Value& value) {
+    const Key& k = key(value);
+    leaf_ptr leaf = descend_lower(k);
+    size_type i = leaf_lower(leaf, k);
+    iterator j = normalize(leaf, i);
+    if (j.index != j.node->count && !key_compare(k, key(*j)))
+        return std::pair<iterator, bool>(j, false);
+    return std::pair<iterator, bool>(insert_in_leaf(leaf, i, value), true);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::iterator
+btree<Key, Value, KeyOfValue, Compare>::insert_equal(const Value& value) {
+    leaf_ptr leaf = descend_upper(key(value));
+    return insert_in_leaf(leaf, leaf_upper(leaf, key(value)), value);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::iterator
+btree<Key, Value, KeyOfValue, Compare>::insert_unique(
+    const_iterator position, const Value& value) {
+    if (position == end() &&
+        (empty() || key_compare(key(rightmost->data()[rightmost->count - 1]),
+                                key(value))))
+        return insert_in_leaf(rightmost, rightmost->count, value);
+    return insert_unique(value).first;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::iterator
+btree<Key, Value, KeyOfValue, Compare>::insert_equal(
+    const_iterator position, const Value& value) {
+    if (position == end() &&
+        (empty() || !key_compare(key(value),
+                                 key(rightmost->data()[rightmost->count - 1]))))
+        return insert_in_leaf(rightmost, rightmost->count, value);
+    return insert_equal(value);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::size_type
+btree<Key, Value, KeyOfValue, Compare>::erase(const Key& x) {
+    std::pair<iterator, iterator> p = equal_range(x);
+    size_type n = 0;
+    mystl::distance(p.first, p.second, n);
+    erase(p.first, p.second);
+    return n;
+}
+
+// 删除会移动元素，因此先数出个数，再从 first 开始逐个删除
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void btree<Key, Value, KeyOfValue, Compare>::erase(const_iterator first,
+                                                   const_iterator last) {
+    if (first == begin() && last == end()) {
+        clear();
+        return;
+    }
+    size_type n = 0;
+    mystl::distance(first, last, n);
+    for (iterator it = to_iterator(first); n != 0; --n)
+        it = erase_at(it);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::iterator
+btree<Key, Value, KeyOfValue, Compare>::find(const Key& k) {
+    iterator j = lower_bound(k);
+    return (j == end() || key_compare(k, key(*j))) ? end() : j;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename btree<Key, Value, KeyOfValue, Compare>::size_type
+btree<Key, Value, KeyOfValue, Compare>::count(const Key& k) const {
+    std::pair<const_iterator, const_iterator> p = equal_range(k);
+    size_type n = 0;
+    mystl::distance(p.first, p.second, n);
+    return n;
+}
+
+// 检查键的顺序、分隔键的范围、父指针、叶节点深度、节点的填充率以及叶节点链表
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+bool btree<Key, Value, KeyOfValue, Compare>::verify_aux(base_ptr x,
+                                                        const Key* lo,
+                                                        const Key* hi,
+                                                        size_type depth,
+                                                        size_type& leaf_depth,
+                                                        size_type& n) const {
+    if (x->leaf) {
+        leaf_ptr y = as_leaf(x);
+        if (leaf_depth == size_type(-1))
+            leaf_depth = depth;
+        if (leaf_depth != depth || (x != root && y->count < leaf_min) ||
+            y->count > leaf_capacity)
+            return false;
+        for (size_type i = 0; i != y->count; ++i) {
+            const Key& k = key(y->data()[i]);
+            if ((lo && key_compare(k, *lo)) || (hi && key_compare(*hi, k)))
+                return false;
+            if (i && key_compare(k, key(y->data()[i - 1])))
+                return false;
+        }
+        n += y->count;
+        return true;
+    }
+    inner_ptr y = as_inner(x);
+    if ((x != root && y->count < inner_min) || y->count > inner_capacity ||
+        y->count == 0)
+        return false;
+    for (size_type i = 0; i <= y->count; ++i) {
+        if (y->children[i]->parent != x)
+            return false;
+        const Key* l = i == 0 ? lo : y->keys() + i - 1;
+        const Key* h = i == y->count ? hi : y->keys() + i;
+        if (!verify_aux(y->children[i], l, h, depth + 1, leaf_depth, n))
+            return false;
+    }
+    return true;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+bool btree<Key, Value, KeyOfValue, Compare>::verify() const {
+    size_type leaf_depth = size_type(-1);
+    size_type n = 0;
+    if (root->parent != 0 || !verify_aux(root, 0, 0, 0, leaf_depth, n) ||
+        n != node_count)
+        return false;
+    // 叶节点链表按顺序覆盖全部元素
+    n = 0;
+    leaf_ptr prev = 0;
+    for (leaf_ptr x = leftmost; x != 0; prev = x, x = x->next) {
+        if (x->prev != prev)
+            return false;
+        n += x->count;
+    }
+    return prev == rightmost && n == node_count;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+inline bool operator==(const btree<Key, Value, KeyOfValue, Compare>& lhs,
+                       const btree<Key, Value, KeyOfValue, Compare>& rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+inline bool operator<(const btree<Key, Value, KeyOfValue, Compare>& lhs,
+                      const btree<Key, Value, KeyOfValue, Compare>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                        rhs.end());
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+inline void swap(btree<Key, Value, KeyOfValue, Compare>& lhs,
+                 btree<Key, Value, KeyOfValue, Compare>& rhs) {
+    lhs.swap(rhs);
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_BTREE_H_
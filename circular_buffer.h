@@ -0,0 +1,349 @@
+#if !defined(MYSTL_CIRCULAR_BUFFER_H_)
+#define MYSTL_CIRCULAR_BUFFER_H_
+
+// 该头文件用以实现 circular_buffer，一个可增长的连续环形缓冲区
+// 容量总是 2 的幂，下标用掩码取模，两端的插入删除均摊 O(1)
+
+#include <initializer_list>
+#include <type_traits>
+#include "memory.h"
+
+namespace mystl {
+
+template <typename T, typename Ref, typename Ptr>
+struct circular_buffer_iterator {
+    using iterator_category = random_access_iterator_tag;
+    using value_type        = T;
+    using pointer           = Ptr;
+    using reference         = Ref;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+    using iterator          = circular_buffer_iterator<T, T&, T*>;
+    using const_iterator    = circular_buffer_iterator<T, const T&, const T*>;
+    using self              = circular_buffer_iterator;
+
+    // 记录缓冲区首地址、掩码以及相对于缓冲区首地址的逻辑下标
+    T* buffer;
+    size_type mask;
+    size_type index;
+
+    circular_buffer_iterator() : buffer(0), mask(0), index(0) {}
+    circular_buffer_iterator(T* buf, size_type m, size_type i)
+        : buffer(buf), mask(m), index(i) {}
+    template <typename Iter, typename = typename std::enable_if<
+                                 std::is_same<Iter, iterator>::value>::type>
+    circular_buffer_iterator(const Iter& iter)
+        : buffer(iter.buffer), mask(iter.mask), index(iter.index) {}
+
+    reference operator*() const { return buffer[index & mask]; }
+    pointer operator->() const { return &(operator*()); }
+    difference_type operator-(const self& iter) const {
+        return difference_type(index - iter.index);
+    }
+    self& operator++() {
+        ++index;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++index;
+        return tmp;
+    }
+    self& operator--() {
+        --index;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --index;
+        return tmp;
+    }
+    self& operator+=(difference_type n) {
+        index += n;
+        return *this;
+    }
+    self operator+(difference_type n) const {
+        self tmp = *this;
+        return tmp += n;
+    }
+    self& operator-=(difference_type n) { return *this += -n; }
+    self operator-(difference_type n) const {
+        self tmp = *this;
+        return tmp -= n;
+    }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    bool operator==(const self& iter) const { return index == iter.index; }
+    bool operator!=(const self& iter) const { return !(*this == iter); }
+    bool operator<(const self& iter) const {
+        return difference_type(index - iter.index) < 0;
+    }
+    bool operator>(const self& iter) const { return iter < *this; }
+    bool operator<=(const self& iter) const { return !(iter < *this); }
+    bool operator>=(const self& iter) const { return !(*this < iter); }
+    friend self operator+(difference_type n, const self& iter) {
+        return iter + n;
+    }
+};  // end circular_buffer_iterator
+
+template <typename T, typename Allocator = alloc<T>>
+class circular_buffer {
+public:
+    using value_type        = T;
+    using pointer           = T*;
+    using const_pointer     = const T*;
+    using reference         = T&;
+    using const_reference   = const T&;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+    using iterator          = circular_buffer_iterator<T, T&, T*>;
+    using const_iterator    = circular_buffer_iterator<T, const T&, const T*>;
+
+    using reverse_iter       = reverse_iterator<iterator, T>;
+    using const_reverse_iter = reverse_iterator<const_iterator, T, const_reference, difference_type>;
+
+protected:
+    // head 为首元素的逻辑下标，容量为 0 时 buffer 为空指针
+    pointer buffer;
+    size_type head;
+    size_type count;
+    size_type cap;
+
+    static size_type init_capacity() { return 8; }
+    static size_type round_up_capacity(size_type n) {
+        size_type result = init_capacity();
+        while (result < n)
+            result <<= 1;
+        return result;
+    }
+    size_type mask() const { return cap - 1; }
+    pointer slot(size_type index) const { return buffer + (index & mask()); }
+
+    void reallocate(size_type new_cap);
+    void reallocate_insert(const T& value, bool at_front);
+    void deallocate() {
+        if (buffer) Allocator::deallocate(buffer, cap);
+    }
+    void fill_init(size_type n, const T& value);
+    template <typename InputIterator>
+    void copy_init(InputIterator first, InputIterator last);
+
+public:
+    // 构造与析构函数
+    circular_buffer() : buffer(0), head(0), count(0), cap(0) {}
+    circular_buffer(size_type n, const T& value) { fill_init(n, value); }
+    circular_buffer(int n, const T& value) { fill_init(size_type(n), value); }
+    circular_buffer(long n, const T& value) { fill_init(size_type(n), value); }
+    explicit circular_buffer(size_type n) { fill_init(n, T()); }
+    circular_buffer(const circular_buffer<T, Allocator>& rhs) {
+        copy_init(rhs.begin(), rhs.end());
+    }
+    template <typename InputIterator>
+    circular_buffer(InputIterator first, InputIterator last) {
+        copy_init(first, last);
+    }
+    circular_buffer(std::initializer_list<T> rhs) {
+        copy_init(rhs.begin(), rhs.end());
+    }
+    circular_buffer<T, Allocator>& operator=(const circular_buffer<T, Allocator>& rhs);
+    ~circular_buffer() {
+        clear();
+        deallocate();
+    }
+
+    // 迭代器相关操作
+    iterator begin() noexcept { return iterator(buffer, mask(), head); }
+    const_iterator begin() const noexcept { return const_iterator(buffer, mask(), head); }
+    iterator end() noexcept { return iterator(buffer, mask(), head + count); }
+    const_iterator end() const noexcept { return const_iterator(buffer, mask(), head + count); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iter rbegin() noexcept { return reverse_iter(end()); }
+    const_reverse_iter rbegin() const noexcept { return const_reverse_iter(end()); }
+    reverse_iter rend() noexcept { return reverse_iter(begin()); }
+    const_reverse_iter rend() const noexcept { return const_reverse_iter(begin()); }
+
+    // 容量相关操作
+    size_type size() const { return count; }
+    size_type max_size() const { return size_type(-1) / sizeof(T); }
+    size_type capacity() const { return cap; }
+    bool empty() const { return count == 0; }
+    void reserve(size_type n) {
+        if (n > cap) reallocate(round_up_capacity(n));
+    }
+
+    // 访问相关操作
+    reference front() { return *slot(head); }
+    const_reference front() const { return *slot(head); }
+    reference back() { return *slot(head + count - 1); }
+    const_reference back() const { return *slot(head + count - 1); }
+    reference operator[](size_type n) { return *slot(head + n); }
+    const_reference operator[](size_type n) const { return *slot(head + n); }
+
+    // 修改容器的操作
+    void push_back(const T& value) {
+        if (count == cap) {
+            reallocate_insert(value, false);
+            return;
+        }
+        mystl::construct(slot(head + count), value);
+        ++count;
+    }
+    void push_front(const T& value) {
+        if (count == cap) {
+            reallocate_insert(value, true);
+            return;
+        }
+        mystl::construct(slot(head - 1), value);
+        --head;
+        ++count;
+    }
+    void pop_back() {
+        --count;
+        mystl::destroy(slot(head + count));
+    }
+    void pop_front() {
+        mystl::destroy(slot(head));
+        ++head;
+        --count;
+    }
+    void swap(circular_buffer<T, Allocator>& rhs);
+    void clear();
+};  // end class circular_buffer
+
+/* circular_buffer 内部辅助函数的实现 */
+
+// 重新分配空间，并把元素按逻辑顺序搬到新缓冲区的开头
+template <typename T, typename Alloc>
+void circular_buffer<T, Alloc>::reallocate(size_type new_cap) {
+    pointer new_buffer = Alloc::allocate(new_cap);
+    try {
+        mystl::uninitialized_copy(begin(), end(), new_buffer);
+    } catch (...) {
+        Alloc::deallocate(new_buffer, new_cap);
+        throw;
+    }
+    size_type n = count;
+    clear();
+    deallocate();
+    buffer = new_buffer;
+    head = 0;
+    count = n;
+    cap = new_cap;
+}
+
+// 满时插入：先在新缓冲区中构造新元素，再搬移旧元素并释放旧空间，
+// value 可能引用容器中的元素，必须在旧空间释放之前使用
+template <typename T, typename Alloc>
+void circular_buffer<T, Alloc>::reallocate_insert(const T& value,
+                                                  bool at_front) {
+    size_type new_cap = cap ? cap * 2 : init_capacity();
+    pointer new_buffer = Alloc::allocate(new_cap);
+    pointer pos = at_front ? new_buffer + new_cap - 1 : new_buffer + count;
+    try {
+        mystl::construct(pos, value);
+    } catch (...) {
+        Alloc::deallocate(new_buffer, new_cap);
+        throw;
+    }
+    try {
+        mystl::uninitialized_copy(begin(), end(), new_buffer);
+    } catch (...) {
+        mystl::destroy(pos);
+        Alloc::deallocate(new_buffer, new_cap);
+        throw;
+    }
+    size_type n = count;
+    clear();
+    deallocate();
+    buffer = new_buffer;
+    head = at_front ? new_cap - 1 : 0;
+    count = n + 1;
+    cap = new_cap;
+}
+
+template <typename T, typename Alloc>
+void circular_buffer<T, Alloc>::fill_init(size_type n, const T& value) {
+    buffer = 0;
+    head = count = cap = 0;
+    if (n == 0) return;
+    cap = round_up_capacity(n);
+    buffer = Alloc::allocate(cap);
+    try {
+        mystl::uninitialized_fill_n(buffer, n, value);
+    } catch (...) {
+        Alloc::deallocate(buffer, cap);
+        throw;
+    }
+    count = n;
+}
+
+template <typename T, typename Alloc>
+template <typename InputIterator>
+void circular_buffer<T, Alloc>::copy_init(InputIterator first, InputIterator last) {
+    buffer = 0;
+    head = count = cap = 0;
+    size_type n = mystl::distance(first, last);
+    if (n == 0) return;
+    cap = round_up_capacity(n);
+    buffer = Alloc::allocate(cap);
+    try {
+        mystl::uninitialized_copy(first, last, buffer);
+    } catch (...) {
+        Alloc::deallocate(buffer, cap);
+        throw;
+    }
+    count = n;
+}
+
+/* circular_buffer 其余接口实现 */
+
+template <typename T, typename Alloc>
+circular_buffer<T, Alloc>& circular_buffer<T, Alloc>::operator=(
+    const circular_buffer<T, Alloc>& rhs) {
+    if (&rhs != this) {
+        circular_buffer<T, Alloc> tmp(rhs);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template <typename T, typename Alloc>
+void circular_buffer<T, Alloc>::swap(circular_buffer<T, Alloc>& rhs) {
+    std::swap(buffer, rhs.buffer);
+    std::swap(head, rhs.head);
+    std::swap(count, rhs.count);
+    std::swap(cap, rhs.cap);
+}
+
+template <typename T, typename Alloc>
+void circular_buffer<T, Alloc>::clear() {
+    for (; count != 0; --count, ++head)
+        mystl::destroy(slot(head));
+    head = 0;
+}
+
+template <typename T, typename Alloc>
+inline bool operator==(const circular_buffer<T, Alloc>& lhs,
+                       const circular_buffer<T, Alloc>& rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename Alloc>
+inline bool operator<(const circular_buffer<T, Alloc>& lhs,
+                      const circular_buffer<T, Alloc>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                        rhs.end());
+}
+
+template <typename T, typename Alloc>
+inline void swap(circular_buffer<T, Alloc>& lhs, circular_buffer<T, Alloc>& rhs) {
+    lhs.swap(rhs);
+}
+}  // namespace mystl
+
+#endif  // MYSTL_CIRCULAR_BUFFER_H_
@@ -0,0 +1,298 @@
+#if !defined(MYSTL_CONCURRENT_SET_H_)
+#define MYSTL_CONCURRENT_SET_H_
+
+#include <stddef.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <new>
+#include "construct.h"
+#include "epoch.h"
+
+/* 本头文件实现了一个读多写少的并发有序集合，底层为跳表
+ * 读者（count、lower_bound、for_each）不加锁，可以与写者并发执行；
+ * 写者（insert、erase、clear）之间用互斥锁串行化。
+ * 写者插入时先填好新节点的后继再自下而上发布，读者看到的总是完整的节点；
+ * 删除时自上而下摘除，摘下的节点交给 epoch_domain 延迟释放，
+ * 正在其上行走的读者仍可以顺着它原来的后继继续查找。
+ * 没有采用红黑树：旋转会同时改动多个指针，读者可能在中途看到不一致的结构，
+ * 而跳表的每次修改都是单个指针的原子替换 */
+namespace mystl {
+
+template <typename Value>
+struct skiplist_node {
+    using link_type = skiplist_node<Value>*;
+
+    Value       value;
+    size_t      retire_epoch;   // 被摘除时的纪元
+    link_type   retire_next;    // 待释放链表，只由写者访问
+    int         height;
+
+    // 各层后继紧跟在节点之后，与节点一起分配
+    std::atomic<link_type>* next() {
+        return reinterpret_cast<std::atomic<link_type>*>(this + 1);
+    }
+};
+
+template <typename Key, typename Compare = std::less<Key>>
+class concurrent_set {
+public:
+    using key_type          = Key;
+    using value_type        = Key;
+    using key_compare       = Compare;
+    using value_compare     = Compare;
+    using size_type         = size_t;
+    using const_reference   = const Key&;
+
+protected:
+    using node_type = skiplist_node<Key>;
+    using link_type = node_type*;
+
+    enum { max_level = 32 };
+    // 每新增这么多个摘下的节点尝试回收一次
+    enum { retire_batch = 64 };
+
+    link_type head;
+    std::atomic<int> level;
+    std::atomic<size_type> node_count;
+    Compare compare;
+
+    // 以下成员只由持有 writer_lock 的写者访问
+    alignas(cache_line_size) std::mutex writer_lock;
+    link_type retired_head;
+    link_type retired_tail;
+    size_type retired_count;
+    size_type reclaim_at;       // 待释放节点达到该数目时尝试回收
+    size_t seed;
+
+    // 节点大小随层数变化，并且可能在读者线程中与其他容器并发分配释放，
+    // 所以不走 alloc 的内存池
+    static link_type get_node(int height) {
+        link_type tmp = static_cast<link_type>(::operator new(
+            sizeof(node_type) + height * sizeof(std::atomic<link_type>)));
+        tmp->height = height;
+        for (int i = 0; i != height; ++i)
+            new (&tmp->next()[i]) std::atomic<link_type>(NULL);
+        return tmp;
+    }
+    static void put_node(link_type ptr) { ::operator delete(ptr); }
+    static link_type create_node(const value_type& value, int height) {
+        link_type tmp = get_node(height);
+        try {
+            mystl::construct(&tmp->value, value);
+        } catch (...) {
+            put_node(tmp);
+            throw;
+        }
+        return tmp;
+    }
+    static void destroy_node(link_type ptr) {
+        mystl::destroy(&ptr->value);
+        put_node(ptr);
+    }
+
+    // 每层以 1/4 的概率继续升高，平均每个节点 4/3 个指针
+    int random_height() {
+        int height = 1;
+        for (;;) {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            if (height == max_level || (seed & 3) != 0)
+                return height;
+            ++height;
+        }
+    }
+
+    // 返回第一个不小于 k 的节点；必须在 epoch_guard 内或由写者调用
+    link_type lower_bound_node(const key_type& k) const;
+    // 写者专用，preds 中记下每层最后一个小于 k 的节点
+    link_type find_preds(const key_type& k, link_type* preds) const;
+    void retire(link_type x);
+    void reclaim(size_t safe_epoch);
+
+public:
+    explicit concurrent_set(const Compare& comp = Compare())
+        : head(get_node(max_level)), level(1), node_count(0),
+          compare(comp), retired_head(NULL), retired_tail(NULL),
+          retired_count(0), reclaim_at(retire_batch),
+          seed(size_t(this) | 1) {}
+    concurrent_set(const concurrent_set&) = delete;
+    concurrent_set& operator=(const concurrent_set&) = delete;
+    // 析构时不能再有读者
+    ~concurrent_set();
+
+    key_compare key_comp() const { return compare; }
+    // 并发修改时只是一个近似值
+    size_type size() const {
+        return node_count.load(std::memory_order_relaxed);
+    }
+    bool empty() const { return size() == 0; }
+
+    // 写者接口
+    bool insert(const value_type& value);
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+    size_type erase(const key_type& k);
+    void clear();
+
+    // 读者接口，节点随时可能被删除，所以不返回迭代器，而是把元素复制出来
+    size_type count(const key_type& k) const {
+        epoch_guard guard;
+        link_type x = lower_bound_node(k);
+        return (x != NULL && !compare(k, x->value)) ? 1 : 0;
+    }
+    bool contains(const key_type& k) const { return count(k) != 0; }
+    // 找到不小于 k 的元素时复制到 result 并返回 true
+    bool lower_bound(const key_type& k, value_type& result) const {
+        epoch_guard guard;
+        link_type x = lower_bound_node(k);
+        if (x == NULL)
+            return false;
+        result = x->value;
+        return true;
+    }
+    // 按升序对每个元素调用 f，看到的是遍历过程中逐步变化的集合
+    template <typename Function>
+    void for_each(Function f) const {
+        epoch_guard guard;
+        for (link_type x = head->next()[0].load(std::memory_order_acquire);
+             x != NULL; x = x->next()[0].load(std::memory_order_acquire))
+            f(x->value);
+    }
+};  // class concurrent_set
+
+template <typename Key, typename Compare>
+concurrent_set<Key, Compare>::~concurrent_set() {
+    link_type x = head->next()[0].load(std::memory_order_relaxed);
+    while (x != NULL) {
+        link_type next = x->next()[0].load(std::memory_order_relaxed);
+        destroy_node(x);
+        x = next;
+    }
+    reclaim(size_t(-1));
+    put_node(head);
+}
+
+template <typename Key, typename Compare>
+typename concurrent_set<Key, Compare>::link_type
+concurrent_set<Key, Compare>::lower_bound_node(const key_type& k) const {
+    link_type x = head;
+    link_type next = NULL;
+    for (int i = level.load(std::memory_order_acquire) - 1; i >= 0; --i) {
+        next = x->next()[i].load(std::memory_order_acquire);
+        while (next != NULL && compare(next->value, k)) {
+            x = next;
+            next = x->next()[i].load(std::memory_order_acquire);
+        }
+    }
+    return next;
+}
+
+template <typename Key, typename Compare>
+typename concurrent_set<Key, Compare>::link_type
+concurrent_set<Key, Compare>::find_preds(const key_type& k,
+                                         link_type* preds) const {
+    link_type x = head;
+    link_type next = NULL;
+    int i = max_level - 1;
+    for (int top = level.load(std::memory_order_relaxed); i >= top; --i)
+        preds[i] = head;
+    for (; i >= 0; --i) {
+        next = x->next()[i].load(std::memory_order_relaxed);
+        while (next != NULL && compare(next->value, k)) {
+            x = next;
+            next = x->next()[i].load(std::memory_order_relaxed);
+        }
+        preds[i] = x;
+    }
+    return next;
+}
+
+// 先填好新节点各层的后继，再从第 0 层向上逐层发布
+template <typename Key, typename Compare>
+bool concurrent_set<Key, Compare>::insert(const value_type& value) {
+    std::lock_guard<std::mutex> lock(writer_lock);
+    link_type preds[max_level];
+    link_type x = find_preds(value, preds);
+    if (x != NULL && !compare(value, x->value))
+        return false;
+    int height = random_height();
+    link_type tmp = create_node(value, height);
+    for (int i = 0; i != height; ++i)
+        tmp->next()[i].store(preds[i]->next()[i].load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+    if (height > level.load(std::memory_order_relaxed))
+        level.store(height, std::memory_order_release);
+    for (int i = 0; i != height; ++i)
+        preds[i]->next()[i].store(tmp, std::memory_order_release);
+    node_count.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// 自上而下摘除，节点本身的后继保持不变，随后交给 retire 延迟释放
+template <typename Key, typename Compare>
+typename concurrent_set<Key, Compare>::size_type
+concurrent_set<Key, Compare>::erase(const key_type& k) {
+    std::lock_guard<std::mutex> lock(writer_lock);
+    link_type preds[max_level];
+    link_type x = find_preds(k, preds);
+    if (x == NULL || compare(k, x->value))
+        return 0;
+    for (int i = x->height - 1; i >= 0; --i)
+        preds[i]->next()[i].store(
+            x->next()[i].load(std::memory_order_relaxed),
+            std::memory_order_release);
+    node_count.fetch_sub(1, std::memory_order_relaxed);
+    retire(x);
+    return 1;
+}
+
+template <typename Key, typename Compare>
+void concurrent_set<Key, Compare>::clear() {
+    std::lock_guard<std::mutex> lock(writer_lock);
+    link_type x = head->next()[0].load(std::memory_order_relaxed);
+    for (int i = 0; i != max_level; ++i)
+        head->next()[i].store(NULL, std::memory_order_release);
+    node_count.store(0, std::memory_order_relaxed);
+    while (x != NULL) {
+        link_type next = x->next()[0].load(std::memory_order_relaxed);
+        retire(x);
+        x = next;
+    }
+}
+
+// 待释放链表按纪元递增排列，攒够一批后推进纪元，释放所有读者都不可能再看到的节点；
+// 有读者长时间停留在临界区时回收不了，下一次尝试要再等一批，避免每次删除都扫描槽位
+template <typename Key, typename Compare>
+void concurrent_set<Key, Compare>::retire(link_type x) {
+    x->retire_epoch = epoch_domain::instance().current();
+    x->retire_next = NULL;
+    if (retired_tail == NULL)
+        retired_head = x;
+    else
+        retired_tail->retire_next = x;
+    retired_tail = x;
+    if (++retired_count >= reclaim_at) {
+        reclaim(epoch_domain::instance().advance());
+        reclaim_at = retired_count + retire_batch;
+    }
+}
+
+template <typename Key, typename Compare>
+void concurrent_set<Key, Compare>::reclaim(size_t safe_epoch) {
+    while (retired_head != NULL && retired_head->retire_epoch < safe_epoch) {
+        link_type x = retired_head;
+        retired_head = x->retire_next;
+        destroy_node(x);
+        --retired_count;
+    }
+    if (retired_head == NULL)
+        retired_tail = NULL;
+}
+}  // namespace mystl
+
+#endif  // MYSTL_CONCURRENT_SET_H_
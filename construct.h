@@ -37,7 +37,7 @@ inline void destroy_aux(ForwardIterator first,
                         ForwardIterator last,
                         _false_type) {
     for (; first != last; ++first)
-        destroy(first);
+        mystl::destroy(&*first);
 }
 
 // 两个参数的全局 destroy 函数，根据其是否具有 trivial 析构函数进行重载
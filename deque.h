@@ -56,6 +56,7 @@ struct deque_iterator {
             set_node(node + 1);
             cur = first;
         }
+        return *this;
     }
     self operator++(int) {
         self tmp = *this;
@@ -77,7 +78,7 @@ struct deque_iterator {
     }
     self& operator+=(difference_type n) {
         difference_type offset = n + (cur - first);
-        if (offset >= 0 && offset < buffer_size())
+        if (offset >= 0 && offset < difference_type(buffer_size()))
             cur += n;
         else {
             difference_type node_offset =
@@ -85,7 +86,7 @@ struct deque_iterator {
                     ? difference_type(offset / buffer_size())
                     : -difference_type((-offset - 1) / buffer_size()) - 1;
             set_node(node + node_offset);
-            cur = first + (offset - node_offset) * buffer_size();
+            cur = first + (offset - node_offset * difference_type(buffer_size()));
         }
         return *this;
     }
@@ -107,7 +108,7 @@ struct deque_iterator {
     }
 };  // end deque_iterator
 
-template <typename T>
+template <typename T, typename Alloc = alloc<T>>
 class deque {
    public:
     using value_type = T;
@@ -130,8 +131,9 @@ class deque {
 
    protected:
     using map_pointer = pointer*;
-    using data_alloc = alloc<value_type>;
-    using map_alloc = alloc<pointer>;
+    // 缓冲区使用 Alloc 分配，中控器 map 则通过 rebind 得到对应的分配器
+    using data_alloc = Alloc;
+    using map_alloc = typename Alloc::template rebind<pointer>::other;
 
     /* 内部成员 */
 
@@ -176,7 +178,9 @@ class deque {
     void reallocate_map(size_type nodes_to_add, bool add_at_front);
 
     pointer allocate_node() { return data_alloc::allocate(buffer_size()); }
-    void deallocate_node(pointer ptr) { data_alloc::deallocate(ptr); }
+    void deallocate_node(pointer ptr) {
+        data_alloc::deallocate(ptr, buffer_size());
+    }
 
    public:
     deque() { create_map_nodes(0); }
@@ -190,7 +194,7 @@ class deque {
         copy_init(first, last);
     }
     ~deque() {
-        destroy(start, finish);
+        mystl::destroy(start, finish);
         destroy_map_nodes();
     }
     deque& operator=(const deque& rhs);
@@ -263,11 +267,11 @@ class deque {
     void clear();
 
     /* 比较操作符的重载 */
-    bool operator==(const deque<T>& rhs) {
+    bool operator==(const deque<T, Alloc>& rhs) {
         return size() == rhs.size() && std::equal(begin(), end(), rhs.begin());
     }
-    bool operator!=(const deque<T>& rhs) { return !(*this == rhs); }
-    bool operator<(const deque<T>& rhs) {
+    bool operator!=(const deque<T, Alloc>& rhs) { return !(*this == rhs); }
+    bool operator<(const deque<T, Alloc>& rhs) {
         return std::lexicographical_compare(begin(), end(), rhs.begin(),
                                             rhs.end());
     }
@@ -275,8 +279,8 @@ class deque {
 
 /* deque 内部辅助函数的实现 */
 
-template <typename T>
-void deque<T>::create_map_nodes(size_type num_element) {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::create_map_nodes(size_type num_element) {
     size_type num_nodes = num_element / buffer_size() + 1;
     map_size = std::max(init_map_size(), num_nodes + 2);
     map = map_alloc::allocate(map_size);
@@ -298,15 +302,15 @@ void deque<T>::create_map_nodes(size_type num_element) {
     finish.cur = finish.first + (num_element % buffer_size());
 }
 
-template <typename T>
-void deque<T>::destroy_map_nodes() {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::destroy_map_nodes() {
     for (map_pointer cur = start.node; cur <= finish.node; ++cur)
         deallocate_node(*cur);
     map_alloc::deallocate(map, map_size);
 }
 
-template <typename T>
-void deque<T>::reallocate_map(size_type nodes_to_add, bool add_at_front) {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::reallocate_map(size_type nodes_to_add, bool add_at_front) {
     size_type old_nodes_num = finish.node - start.node + 1;
     size_type new_nodes_num = old_nodes_num + nodes_to_add;
     map_pointer new_nstart;
@@ -333,8 +337,8 @@ void deque<T>::reallocate_map(size_type nodes_to_add, bool add_at_front) {
     finish.set_node(new_nstart + old_nodes_num - 1);
 }
 
-template <typename T>
-typename deque<T>::iterator deque<T>::reserve_elements_at_front(size_type n) {
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::reserve_elements_at_front(size_type n) {
     size_type remain = start.cur - start.first;
     if (n > remain) {
         size_type new_elements = n - remain;
@@ -353,8 +357,8 @@ typename deque<T>::iterator deque<T>::reserve_elements_at_front(size_type n) {
     return start - difference_type(n);
 }
 
-template <typename T>
-typename deque<T>::iterator deque<T>::reserve_elements_at_back(size_type n) {
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::reserve_elements_at_back(size_type n) {
     size_type remain = finish.last - finish.cur;
     if (n > remain) {
         size_type new_elements = n - remain;
@@ -373,20 +377,20 @@ typename deque<T>::iterator deque<T>::reserve_elements_at_back(size_type n) {
     return finish + difference_type(n);
 }
 
-template <typename T>
-void deque<T>::destroy_nodes_at_front(iterator before_start) {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::destroy_nodes_at_front(iterator before_start) {
     for (map_pointer n = before_start.node; n < start.node; ++n)
         deallocate_node(*n);
 }
 
-template <typename T>
-void deque<T>::destroy_nodes_at_back(iterator after_finish) {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::destroy_nodes_at_back(iterator after_finish) {
     for (map_pointer n = after_finish.node; n > finish.node; --n)
         deallocate_node(*n);
 }
 
-template <typename T>
-void deque<T>::insert_aux(iterator pos, size_type n, const value_type& value) {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::insert_aux(iterator pos, size_type n, const value_type& value) {
     const difference_type elems_before = pos - start;
     size_type length = size();
     if (elems_before < length / 2) {
@@ -397,13 +401,13 @@ void deque<T>::insert_aux(iterator pos, size_type n, const value_type& value) {
         try {
             if (elems_before >= n) {
                 iterator start_n = start + n;
-                uninitialized_copy(start, start_n, new_start);
+                mystl::uninitialized_copy(start, start_n, new_start);
                 start = new_start;
                 std::copy(start_n, pos, old_start);
                 std::fill(pos - n, pos, value);
             } else {
-                iterator mid = uninitialized_copy(start, pos, new_start);
-                uninitialized_fill(mid, start, value);
+                iterator mid = mystl::uninitialized_copy(start, pos, new_start);
+                mystl::uninitialized_fill(mid, start, value);
                 start = new_start;
                 std::fill(old_start, pos, value);
             }
@@ -420,15 +424,15 @@ void deque<T>::insert_aux(iterator pos, size_type n, const value_type& value) {
         try {
             if (elems_after > n) {
                 iterator finish_n = finish - n;
-                uninitialized_copy(finish_n, finish, finish);
+                mystl::uninitialized_copy(finish_n, finish, finish);
                 finish = new_finish;
                 std::copy_backward(pos, finish_n, old_finish);
                 std::fill(pos, pos + n, value);
             } else {
-                uninitialized_fill(finish, pos + n, value);
-                uninitialized_copy(pos, finish, pos + n);
+                mystl::uninitialized_fill(finish, pos + n, value);
+                mystl::uninitialized_copy(pos, finish, pos + n);
                 finish = new_finish;
-                fill(pos, old_finish, value);
+                std::fill(pos, old_finish, value);
             }
         } catch (...) {
             destroy_nodes_at_back(new_finish);
@@ -436,33 +440,33 @@ void deque<T>::insert_aux(iterator pos, size_type n, const value_type& value) {
     }
 }
 
-template <typename T>
-void deque<T>::fill_init(size_type n, const value_type& value) {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::fill_init(size_type n, const value_type& value) {
     create_map_nodes(n);
     map_pointer cur;
     try {
         for(cur = start.node; cur < finish.node; ++cur)
-            uninitialized_fill(*cur, *cur + buffer_size(), value);
-        uninitialized_fill(finish.first, finish.cur, value);
+            mystl::uninitialized_fill(*cur, *cur + buffer_size(), value);
+        mystl::uninitialized_fill(finish.first, finish.cur, value);
     }
     catch(...) {
         for (map_pointer n = start.node; n < cur; ++n)
-            destroy(*n, *n + buffer_size());
+            mystl::destroy(*n, *n + buffer_size());
         destroy_map_nodes();
         throw;
     }
 }
 
-template <typename T>
+template <typename T, typename Alloc>
 template <typename InputIterator>
-void deque<T>::copy_init(InputIterator first, InputIterator last) {
+void deque<T, Alloc>::copy_init(InputIterator first, InputIterator last) {
     create_map_nodes(0);
     for (; first != last; ++first)
         push_back(*first);
 }
 /* deque 公开接口的实现 */
-template <typename T>
-deque<T>& deque<T>::operator=(const deque& rhs) {
+template <typename T, typename Alloc>
+deque<T, Alloc>& deque<T, Alloc>::operator=(const deque& rhs) {
     const size_type len = size();
     if (&rhs != this) {
         if (len >= rhs.size())
@@ -476,24 +480,24 @@ deque<T>& deque<T>::operator=(const deque& rhs) {
     return *this;
 }
 
-template <typename T>
-void deque<T>::swap(deque<T>& deq) {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::swap(deque<T, Alloc>& deq) {
     std::swap(start, deq.start);
     std::swap(finish, deq.finish);
     std::swap(map, deq.map);
     std::swap(map_size, deq.map_size);
 }
 
-template <typename T>
-void deque<T>::push_back(const value_type& value) {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::push_back(const value_type& value) {
     if (finish.cur != finish.last - 1) {
-        construct(finish.cur, value);
+        mystl::construct(finish.cur, value);
         ++finish.cur;
     } else {
         reserve_map_at_back();
         *(finish.node + 1) = allocate_node();
         try {
-            construct(finish.cur, value);
+            mystl::construct(finish.cur, value);
             finish.set_node(finish.node + 1);
             finish.cur = finish.first;
         } catch (...) {
@@ -502,40 +506,40 @@ void deque<T>::push_back(const value_type& value) {
     }
 }
 
-template <typename T>
-void deque<T>::push_front(const value_type& value) {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::push_front(const value_type& value) {
     if (start.cur != start.first) {
         --start.cur;
-        construct(start.cur, value);
+        mystl::construct(start.cur, value);
     } else {
         reserve_map_at_front();
         *(start.node - 1) = allocate_node();
         try {
             start.set_node(start.node - 1);
             start.cur = start.last - 1;
-            construct(start.cur, value);
+            mystl::construct(start.cur, value);
         } catch (...) {
             deallocate_node(*(start.node - 1));
         }
     }
 }
 
-template <typename T>
-void deque<T>::pop_back() {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::pop_back() {
     if (finish.cur != finish.first) {
         --finish.cur;
-        destroy(finish.cur);
+        mystl::destroy(finish.cur);
     } else {
         deallocate_node(finish.first);
         finish.set_node(finish.node - 1);
         finish.cur = finish.last - 1;
-        destroy(finish.cur);
+        mystl::destroy(finish.cur);
     }
 }
 
-template <typename T>
-void deque<T>::pop_front() {
-    destroy(start.cur);
+template <typename T, typename Alloc>
+void deque<T, Alloc>::pop_front() {
+    mystl::destroy(start.cur);
     if (start.cur != start.last - 1) {
         ++start.cur;
     } else {
@@ -545,8 +549,8 @@ void deque<T>::pop_front() {
     }
 }
 
-template <typename T>
-typename deque<T>::iterator deque<T>::insert(iterator pos,
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::insert(iterator pos,
                                              const value_type& value) {
     if (pos.cur == start.cur) {
         push_front(value);
@@ -577,28 +581,28 @@ typename deque<T>::iterator deque<T>::insert(iterator pos,
     }
 }
 
-template <typename T>
-void deque<T>::insert(iterator pos, size_type n, const value_type& value) {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::insert(iterator pos, size_type n, const value_type& value) {
     if (pos.cur == start.cur) {
         iterator new_start = reserve_elements_at_front(n);
-        uninitialized_fill(new_start, start, value);
+        mystl::uninitialized_fill(new_start, start, value);
         start = new_start;
     } else if (pos.cur == finish.cur) {
         iterator new_finish = reserve_elements_at_back(n);
-        uninitialized_fill(finish, new_finish, value);
+        mystl::uninitialized_fill(finish, new_finish, value);
         finish = new_finish;
     } else
         insert_aux(pos, n, value);
 }
 
-template <typename T>
+template <typename T, typename Alloc>
 template <typename InputIterator>
-void deque<T>::insert(iterator pos, InputIterator first, InputIterator last) {
-    copy(first, last, std::inserter(*this, pos));
+void deque<T, Alloc>::insert(iterator pos, InputIterator first, InputIterator last) {
+    std::copy(first, last, std::inserter(*this, pos));
 }
 
-template <typename T>
-void deque<T>::resize(size_type new_size, const value_type& value) {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::resize(size_type new_size, const value_type& value) {
     const size_type len = size();
     if (new_size < len)
         erase(start + new_size, finish);
@@ -606,8 +610,8 @@ void deque<T>::resize(size_type new_size, const value_type& value) {
         insert(finish, new_size - len, value);
 }
 
-template <typename T>
-typename deque<T>::iterator deque<T>::erase(iterator pos) {
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::erase(iterator pos) {
     iterator next = pos;
     ++next;
     difference_type index = pos - start;
@@ -615,14 +619,14 @@ typename deque<T>::iterator deque<T>::erase(iterator pos) {
         std::copy_backward(start, pos, next);
         pop_front();
     } else {
-        copy(next, finish, pos);
-        pop_front();
+        std::copy(next, finish, pos);
+        pop_back();
     }
     return start + index;
 }
 
-template <typename T>
-typename deque<T>::iterator deque<T>::erase(iterator first, iterator last) {
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::erase(iterator first, iterator last) {
     if (first == start && last == finish) {
         clear();
         return finish;
@@ -632,34 +636,35 @@ typename deque<T>::iterator deque<T>::erase(iterator first, iterator last) {
         if (elems_before < (size() - n) / 2) {
             std::copy_backward(start, first, last);
             iterator new_start = start + n;
-            destroy(start, new_start);
-            for (map_pointer cur = start.node; cur < new_start; ++cur)
-                data_alloc::deallocate(*cur, buffer_size());
+            mystl::destroy(start, new_start);
+            for (map_pointer cur = start.node; cur < new_start.node; ++cur)
+                deallocate_node(*cur);
             start = new_start;
         } else {
             std::copy(last, finish, first);
             iterator new_finish = finish - n;
-            destroy(new_finish, finish);
+            mystl::destroy(new_finish, finish);
             for (map_pointer cur = new_finish.node + 1; cur <= finish.node;
                  ++cur)
-                data_alloc::deallocate(*cur, buffer_size());
+                deallocate_node(*cur);
             finish = new_finish;
         }
         return start + elems_before;
     }
 }
 
-template <typename T> void deque<T>::clear() {
+template <typename T, typename Alloc>
+void deque<T, Alloc>::clear() {
     for (map_pointer node = start.node + 1; node < finish.node; ++node) {
-        destroy(*node, *node + buffer_size());
-        data_alloc::deallocate(*node, buffer_size());
+        mystl::destroy(*node, *node + buffer_size());
+        deallocate_node(*node);
     }
     if (start.node != finish.node) {
-        destroy(start.cur, start.last);
-        destroy(finish.first, finish.cur);
-        data_alloc::deallocate(finish.first, buffer_size());
+        mystl::destroy(start.cur, start.last);
+        mystl::destroy(finish.first, finish.cur);
+        deallocate_node(finish.first);
     } else
-        destroy(start.cur, finish.cur);
+        mystl::destroy(start.cur, finish.cur);
     finish = start;
 }
 
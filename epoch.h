@@ -0,0 +1,117 @@
+#if !defined(MYSTL_EPOCH_H_)
+#define MYSTL_EPOCH_H_
+
+#include <stddef.h>
+#include <atomic>
+#include <thread>
+#include "spsc_queue.h"
+
+/* 本头文件实现了基于纪元（epoch）的内存回收，供无锁读的并发容器使用
+ * 读者访问共享节点前进入临界区，在自己的槽位中记下当时的全局纪元；
+ * 写者摘下节点后记下摘除时的纪元 e，先不释放，等所有活跃读者的纪元都大于 e 时，
+ * 这些读者一定是在摘除之后才进入的，不可能再持有该节点，此时才真正释放
+ * 整个进程共用一个 epoch_domain，每个线程第一次进入时占用一个槽位，线程结束时归还 */
+namespace mystl {
+
+class epoch_domain {
+public:
+    enum { max_threads = 128 };
+
+    static epoch_domain& instance() {
+        static epoch_domain domain;
+        return domain;
+    }
+
+    // 读者进出临界区，可以嵌套，只有最外层真正修改槽位
+    void enter() {
+        local_slot& local = local_state();
+        if (local.nesting++ == 0) {
+            local.s->epoch.store(global.load(std::memory_order_seq_cst),
+                                 std::memory_order_relaxed);
+            // 与写者 advance 中的栅栏配对：要么写者看到本槽位，要么读者看到节点已被摘除
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+    void leave() {
+        local_slot& local = local_state();
+        if (--local.nesting == 0)
+            local.s->epoch.store(0, std::memory_order_release);
+    }
+
+    // 写者摘除节点之后调用，返回应记在节点上的纪元
+    // 栅栏保证纪元大于返回值的读者一定能看到之前的摘除
+    size_t current() const {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return global.load(std::memory_order_seq_cst);
+    }
+
+    // 推进全局纪元并返回活跃读者中最小的纪元，纪元小于返回值的节点可以释放
+    size_t advance() {
+        size_t result = global.fetch_add(1, std::memory_order_seq_cst) + 1;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (size_t i = 0; i != max_threads; ++i) {
+            size_t e = slots[i].epoch.load(std::memory_order_acquire);
+            if (e != 0 && e < result)
+                result = e;
+        }
+        return result;
+    }
+
+private:
+    struct alignas(cache_line_size) slot {
+        std::atomic<size_t> epoch;  // 0 表示不在临界区
+        std::atomic<bool>   used;
+    };
+
+    // 线程私有的槽位句柄，线程结束时析构并归还槽位
+    struct local_slot {
+        slot*   s;
+        size_t  nesting;
+
+        local_slot() : s(instance().acquire_slot()), nesting(0) {}
+        ~local_slot() { s->used.store(false, std::memory_order_release); }
+    };
+
+    slot slots[max_threads];
+    alignas(cache_line_size) std::atomic<size_t> global;
+
+    epoch_domain() : global(1) {
+        for (size_t i = 0; i != max_threads; ++i) {
+            slots[i].epoch.store(0, std::memory_order_relaxed);
+            slots[i].used.store(false, std::memory_order_relaxed);
+        }
+    }
+    epoch_domain(const epoch_domain&) = delete;
+    epoch_domain& operator=(const epoch_domain&) = delete;
+
+    static local_slot& local_state() {
+        static thread_local local_slot local;
+        return local;
+    }
+
+    // 槽位用尽时等待其他线程结束
+    slot* acquire_slot() {
+        for (;;) {
+            for (size_t i = 0; i != max_threads; ++i) {
+                bool expected = false;
+                if (!slots[i].used.load(std::memory_order_relaxed) &&
+                    slots[i].used.compare_exchange_strong(
+                        expected, true, std::memory_order_acquire))
+                    return &slots[i];
+            }
+            std::this_thread::yield();
+        }
+    }
+};  // class epoch_domain
+
+// 读者临界区的 RAII 封装，存活期间读到的节点不会被释放
+class epoch_guard {
+public:
+    epoch_guard() { epoch_domain::instance().enter(); }
+    ~epoch_guard() { epoch_domain::instance().leave(); }
+    epoch_guard(const epoch_guard&) = delete;
+    epoch_guard& operator=(const epoch_guard&) = delete;
+};
+}  // namespace mystl
+
+#endif  // MYSTL_EPOCH_H_
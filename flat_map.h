@@ -0,0 +1,215 @@
+#if !defined(MYSTL_FLAT_MAP_H_)
+#define MYSTL_FLAT_MAP_H_
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include "vector.h"
+
+/* 本头文件实现了 flat_map，用按键有序的 vector<pair<Key, T>> 保存元素
+ * 与 flat_set 相同，查找为二分查找，单个插入删除为 O(n)
+ * 元素需要在 vector 中移动，因此 value_type 中的键不是 const，不应通过迭代器修改键 */
+namespace mystl {
+
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class flat_map {
+public:
+    using key_type          = Key;
+    using mapped_type       = T;
+    using value_type        = std::pair<Key, T>;
+    using key_compare       = Compare;
+
+    // 只比较键的函数对象
+    class value_compare {
+        friend class flat_map<Key, T, Compare>;
+
+    protected:
+        Compare comp;
+        value_compare(Compare c) : comp(c) {}
+
+    public:
+        bool operator()(const value_type& x, const value_type& y) const {
+            return comp(x.first, y.first);
+        }
+    };
+
+private:
+    using rep_type = vector<value_type>;
+    rep_type data;
+    Compare comp;
+
+public:
+    using pointer           = typename rep_type::pointer;
+    using const_pointer     = typename rep_type::const_pointer;
+    using reference         = typename rep_type::reference;
+    using const_reference   = typename rep_type::const_reference;
+    using iterator          = typename rep_type::iterator;
+    using const_iterator    = typename rep_type::const_iterator;
+    using difference_type   = typename rep_type::difference_type;
+    using size_type         = typename rep_type::size_type;
+
+public:
+    // 构造函数
+    flat_map() : comp(Compare()) {}
+    explicit flat_map(const Compare& c) : comp(c) {}
+    template <typename InputIterator>
+    flat_map(InputIterator first, InputIterator last) : comp(Compare()) {
+        insert(first, last);
+    }
+    template <typename InputIterator>
+    flat_map(InputIterator first, InputIterator last, const Compare& c)
+        : comp(c) {
+        insert(first, last);
+    }
+    flat_map(std::initializer_list<value_type> rhs) : comp(Compare()) {
+        insert(rhs.begin(), rhs.end());
+    }
+
+    key_compare     key_comp()   const { return comp; }
+    value_compare   value_comp() const { return value_compare(comp); }
+    iterator        begin()            { return data.begin(); }
+    const_iterator  begin()      const { return data.begin(); }
+    iterator        end()              { return data.end(); }
+    const_iterator  end()        const { return data.end(); }
+    bool            empty()      const { return data.empty(); }
+    size_type       size()       const { return data.size(); }
+    size_type       max_size()   const { return data.max_size(); }
+    size_type       capacity()   const { return data.capacity(); }
+    void            reserve(size_type n) { data.reserve(n); }
+    void            swap(flat_map& x) {
+        data.swap(x.data);
+        std::swap(comp, x.comp);
+    }
+
+    // 键不存在时插入 T()
+    T& operator[](const key_type& k) {
+        iterator position = lower_bound(k);
+        if (position == end() || comp(k, position->first))
+            position = data.insert(position, value_type(k, T()));
+        return position->second;
+    }
+    T& at(const key_type& k) {
+        iterator position = find(k);
+        if (position == end())
+            throw std::out_of_range("flat_map::at");
+        return position->second;
+    }
+    const T& at(const key_type& k) const {
+        const_iterator position = find(k);
+        if (position == end())
+            throw std::out_of_range("flat_map::at");
+        return position->second;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& x) {
+        iterator position = lower_bound(x.first);
+        if (position != end() && !comp(x.first, position->first))
+            return std::pair<iterator, bool>(position, false);
+        return std::pair<iterator, bool>(data.insert(position, x), true);
+    }
+
+    // 提示位置正确时省去二分查找
+    iterator insert(iterator position, const value_type& x) {
+        if ((position == begin() || comp((position - 1)->first, x.first)) &&
+            (position == end() || comp(x.first, position->first)))
+            return data.insert(position, x);
+        return insert(x).first;
+    }
+
+    // 已有的元素优先，区间内键重复的元素只保留第一个
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        size_type old_size = data.size();
+        for (; first != last; ++first)
+            data.push_back(*first);
+        iterator middle = data.begin() + old_size;
+        value_compare vc(comp);
+        std::stable_sort(middle, data.end(), vc);
+        std::inplace_merge(data.begin(), middle, data.end(), vc);
+        data.erase(std::unique(data.begin(), data.end(),
+                               [&vc](const value_type& lhs,
+                                     const value_type& rhs) {
+                                   return !vc(lhs, rhs);
+                               }),
+                   data.end());
+    }
+
+    void erase(iterator position) { data.erase(position); }
+    size_type erase(const key_type& x) {
+        iterator position = find(x);
+        if (position == end())
+            return 0;
+        data.erase(position);
+        return 1;
+    }
+    void erase(iterator first, iterator last) { data.erase(first, last); }
+    void clear() { data.clear(); }
+
+    iterator find(const key_type& x) {
+        iterator position = lower_bound(x);
+        return position == end() || comp(x, position->first) ? end()
+                                                              : position;
+    }
+    const_iterator find(const key_type& x) const {
+        return const_cast<flat_map*>(this)->find(x);
+    }
+    size_type count(const key_type& x) const {
+        return find(x) == end() ? 0 : 1;
+    }
+    iterator lower_bound(const key_type& x) {
+        const Compare& c = comp;
+        return std::lower_bound(begin(), end(), x,
+                                [&c](const value_type& v, const Key& k) {
+                                    return c(v.first, k);
+                                });
+    }
+    const_iterator lower_bound(const key_type& x) const {
+        return const_cast<flat_map*>(this)->lower_bound(x);
+    }
+    iterator upper_bound(const key_type& x) {
+        const Compare& c = comp;
+        return std::upper_bound(begin(), end(), x,
+                                [&c](const Key& k, const value_type& v) {
+                                    return c(k, v.first);
+                                });
+    }
+    const_iterator upper_bound(const key_type& x) const {
+        return const_cast<flat_map*>(this)->upper_bound(x);
+    }
+    std::pair<iterator, iterator> equal_range(const key_type& x) {
+        iterator first = lower_bound(x);
+        iterator last = first;
+        if (last != end() && !comp(x, last->first))
+            ++last;
+        return std::pair<iterator, iterator>(first, last);
+    }
+    std::pair<const_iterator, const_iterator> equal_range(
+        const key_type& x) const {
+        return const_cast<flat_map*>(this)->equal_range(x);
+    }
+};  // class flat_map
+
+template <typename Key, typename T, typename Compare>
+inline bool operator==(const flat_map<Key, T, Compare>& lhs,
+                       const flat_map<Key, T, Compare>& rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Key, typename T, typename Compare>
+inline bool operator<(const flat_map<Key, T, Compare>& lhs,
+                      const flat_map<Key, T, Compare>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                        rhs.end());
+}
+
+template <typename Key, typename T, typename Compare>
+inline void swap(flat_map<Key, T, Compare>& lhs,
+                 flat_map<Key, T, Compare>& rhs) {
+    lhs.swap(rhs);
+}
+}  // namespace mystl
+
+#endif  // MYSTL_FLAT_MAP_H_
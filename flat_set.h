@@ -0,0 +1,161 @@
+#if !defined(MYSTL_FLAT_SET_H_)
+#define MYSTL_FLAT_SET_H_
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include "vector.h"
+
+/* 本头文件实现了 flat_set，用有序的 vector 保存元素
+ * 查找为连续内存上的二分查找，单个插入删除为 O(n)，适合读多写少的查找表
+ * 区间插入先追加到末尾，再排序、归并并去重，总代价为 O(n + m log m) */
+namespace mystl {
+
+template <typename Key, typename Compare = std::less<Key>>
+class flat_set {
+private:
+    using rep_type = vector<Key>;
+    rep_type data;
+    Compare comp;
+
+public:
+    using key_type          = Key;
+    using value_type        = Key;
+    using key_compare       = Compare;
+    using value_compare     = Compare;
+
+    using pointer           = typename rep_type::const_pointer;
+    using const_pointer     = typename rep_type::const_pointer;
+    using reference         = typename rep_type::const_reference;
+    using const_reference   = typename rep_type::const_reference;
+    using iterator          = typename rep_type::const_iterator;
+    using const_iterator    = typename rep_type::const_iterator;
+    using difference_type   = typename rep_type::difference_type;
+    using size_type         = typename rep_type::size_type;
+
+private:
+    // 由 const 迭代器得到底层 vector 的可修改迭代器
+    typename rep_type::iterator mutable_iter(const_iterator position) {
+        return data.begin() + (position - data.cbegin());
+    }
+
+public:
+    // 构造函数
+    flat_set() : comp(Compare()) {}
+    explicit flat_set(const Compare& c) : comp(c) {}
+    template <typename InputIterator>
+    flat_set(InputIterator first, InputIterator last) : comp(Compare()) {
+        insert(first, last);
+    }
+    template <typename InputIterator>
+    flat_set(InputIterator first, InputIterator last, const Compare& c)
+        : comp(c) {
+        insert(first, last);
+    }
+    flat_set(std::initializer_list<Key> rhs) : comp(Compare()) {
+        insert(rhs.begin(), rhs.end());
+    }
+
+    key_compare     key_comp()   const { return comp; }
+    value_compare   value_comp() const { return comp; }
+    iterator        begin()      const { return data.begin(); }
+    iterator        end()        const { return data.end(); }
+    bool            empty()      const { return data.empty(); }
+    size_type       size()       const { return data.size(); }
+    size_type       max_size()   const { return data.max_size(); }
+    size_type       capacity()   const { return data.capacity(); }
+    void            reserve(size_type n) { data.reserve(n); }
+    void            swap(flat_set& x) {
+        data.swap(x.data);
+        std::swap(comp, x.comp);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& x) {
+        iterator position = lower_bound(x);
+        if (position != end() && !comp(x, *position))
+            return std::pair<iterator, bool>(position, false);
+        return std::pair<iterator, bool>(data.insert(mutable_iter(position), x),
+                                         true);
+    }
+
+    // 提示位置正确时省去二分查找
+    iterator insert(iterator position, const value_type& x) {
+        if ((position == begin() || comp(*(position - 1), x)) &&
+            (position == end() || comp(x, *position)))
+            return data.insert(mutable_iter(position), x);
+        return insert(x).first;
+    }
+
+    // 已有的元素优先，区间内的重复元素只保留第一个
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        size_type old_size = data.size();
+        for (; first != last; ++first)
+            data.push_back(*first);
+        typename rep_type::iterator middle = data.begin() + old_size;
+        const Compare& c = comp;
+        std::stable_sort(middle, data.end(), c);
+        std::inplace_merge(data.begin(), middle, data.end(), c);
+        data.erase(std::unique(data.begin(), data.end(),
+                               [&c](const Key& lhs, const Key& rhs) {
+                                   return !c(lhs, rhs);
+                               }),
+                   data.end());
+    }
+
+    void erase(iterator position) { data.erase(mutable_iter(position)); }
+    size_type erase(const key_type& x) {
+        std::pair<iterator, iterator> p = equal_range(x);
+        size_type n = p.second - p.first;
+        erase(p.first, p.second);
+        return n;
+    }
+    void erase(iterator first, iterator last) {
+        data.erase(mutable_iter(first), mutable_iter(last));
+    }
+    void clear() { data.clear(); }
+
+    iterator find(const key_type& x) const {
+        iterator position = lower_bound(x);
+        return position == end() || comp(x, *position) ? end() : position;
+    }
+    size_type count(const key_type& x) const {
+        return find(x) == end() ? 0 : 1;
+    }
+    iterator lower_bound(const key_type& x) const {
+        return std::lower_bound(begin(), end(), x, comp);
+    }
+    iterator upper_bound(const key_type& x) const {
+        return std::upper_bound(begin(), end(), x, comp);
+    }
+    std::pair<iterator, iterator> equal_range(const key_type& x) const {
+        iterator first = lower_bound(x);
+        iterator last = first;
+        if (last != end() && !comp(x, *last))
+            ++last;
+        return std::pair<iterator, iterator>(first, last);
+    }
+};  // class flat_set
+
+template <typename Key, typename Compare>
+inline bool operator==(const flat_set<Key, Compare>& lhs,
+                       const flat_set<Key, Compare>& rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Key, typename Compare>
+inline bool operator<(const flat_set<Key, Compare>& lhs,
+                      const flat_set<Key, Compare>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                        rhs.end());
+}
+
+template <typename Key, typename Compare>
+inline void swap(flat_set<Key, Compare>& lhs, flat_set<Key, Compare>& rhs) {
+    lhs.swap(rhs);
+}
+}  // namespace mystl
+
+#endif  // MYSTL_FLAT_SET_H_
@@ -0,0 +1,385 @@
+#if !defined(MYSTL_FORWARD_LIST_H_)
+#define MYSTL_FORWARD_LIST_H_
+
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include "iterator.h"
+#include "memory.h"
+#include "list.h"
+
+/* 本头文件实现了单向链表 forward_list
+ * 节点只有一个 next 指针，比 list_node 每个节点少一个指针，链接时也少一次写操作
+ * 头节点只含 next 指针，直接内嵌在链表对象中 */
+namespace mystl {
+
+struct forward_list_node_base {
+    forward_list_node_base* next;
+};
+
+template <typename T>
+struct forward_list_node : public forward_list_node_base {
+    T data;
+};
+
+template <typename T, typename Ref, typename Ptr>
+struct forward_list_iterator {
+    using iterator          = forward_list_iterator<T, T&, T*>;
+    using const_iterator    = forward_list_iterator<T, const T&, const T*>;
+    using self              = forward_list_iterator<T, Ref, Ptr>;
+
+    using iterator_category = forward_iterator_tag;
+    using value_type        = T;
+    using pointer           = Ptr;
+    using reference         = Ref;
+    using difference_type   = ptrdiff_t;
+    using size_type         = size_t;
+
+    using base_ptr          = forward_list_node_base*;
+    using link_type         = forward_list_node<T>*;
+
+    base_ptr node;
+
+    forward_list_iterator(base_ptr x) : node(x) {}
+    forward_list_iterator() {}
+    // 与 list_iterator 相同，转换构造写成模板，拷贝操作交给编译器
+    template <typename Iter, typename = typename std::enable_if<
+                                 std::is_same<Iter, iterator>::value>::type>
+    forward_list_iterator(const Iter& x) : node(x.node) {}
+
+    bool operator==(const self& rhs) const { return node == rhs.node; }
+    bool operator!=(const self& rhs) const { return !(node == rhs.node); }
+    reference operator*() const { return static_cast<link_type>(node)->data; }
+    pointer operator->() const { return &(operator*()); }
+    self& operator++() {
+        node = node->next;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+};  // end struct forward_list_iterator
+
+template <typename T, typename Alloc = mystl::alloc<forward_list_node<T>>>
+class forward_list {
+   public:
+    using value_type        = T;
+    using pointer           = T*;
+    using const_pointer     = const T*;
+    using reference         = T&;
+    using const_reference   = const T&;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+    using base_ptr          = forward_list_node_base*;
+    using link_type         = forward_list_node<T>*;
+    using iterator          = forward_list_iterator<T, T&, T*>;
+    using const_iterator    = forward_list_iterator<T, const T&, const T*>;
+
+   protected:
+    forward_list_node_base head;  // 头节点，head.next 指向第一个元素，尾节点 next 为空
+
+    /* 内部辅助函数 */
+    link_type get_node() { return Alloc::allocate(); }
+    void put_node(link_type ptr) { Alloc::deallocate(ptr); }
+    link_type create_node(const T& value);
+    void destroy_node(link_type ptr);
+    base_ptr before_head() const { return const_cast<base_ptr>(&head); }
+    // 把 (before_first, before_last] 移动到 pos 之后
+    static void transfer_after(base_ptr pos, base_ptr before_first,
+                               base_ptr before_last);
+
+   public:
+    /* 各种构造拷贝析构函数 */
+    forward_list() { head.next = 0; }
+    forward_list(size_type n, const T& value) {
+        head.next = 0;
+        insert_after(before_begin(), n, value);
+    }
+    forward_list(int n, const T& value) : forward_list(size_type(n), value) {}
+    forward_list(long n, const T& value) : forward_list(size_type(n), value) {}
+    explicit forward_list(size_type n) : forward_list(n, T()) {}
+    template <typename InputIterator>
+    forward_list(InputIterator first, InputIterator last) {
+        head.next = 0;
+        insert_after(before_begin(), first, last);
+    }
+    forward_list(const forward_list& rhs) {
+        head.next = 0;
+        insert_after(before_begin(), rhs.begin(), rhs.end());
+    }
+    forward_list(std::initializer_list<T> rhs) {
+        head.next = 0;
+        insert_after(before_begin(), rhs.begin(), rhs.end());
+    }
+    forward_list& operator=(const forward_list& rhs) {
+        if (&rhs != this) {
+            forward_list tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+    ~forward_list() { clear(); }
+
+    /* 迭代器相关操作 */
+    iterator before_begin() noexcept { return before_head(); }
+    const_iterator before_begin() const noexcept { return before_head(); }
+    iterator begin() noexcept { return head.next; }
+    const_iterator begin() const noexcept { return head.next; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return base_ptr(0); }
+    const_iterator end() const noexcept { return base_ptr(0); }
+    const_iterator cend() const noexcept { return end(); }
+
+    /* 容量相关操作，为保持节点和头部最小，size() 需要遍历一遍 */
+    bool empty() const noexcept { return head.next == 0; }
+    size_type size() const noexcept { return mystl::distance(begin(), end()); }
+    size_type max_size() const noexcept { return size_type(-1); }
+
+    /* 取值相关操作 */
+    reference front() { return static_cast<link_type>(head.next)->data; }
+    const_reference front() const {
+        return static_cast<link_type>(head.next)->data;
+    }
+
+    /* 修改链表操作 */
+    void swap(forward_list& rhs) { std::swap(head.next, rhs.head.next); }
+    iterator insert_after(iterator pos, const T& value);
+    void insert_after(iterator pos, size_type n, const T& value);
+    void insert_after(iterator pos, int n, const T& value) {
+        insert_after(pos, size_type(n), value);
+    }
+    void insert_after(iterator pos, long n, const T& value) {
+        insert_after(pos, size_type(n), value);
+    }
+    template <typename InputIterator>
+    void insert_after(iterator pos, InputIterator first, InputIterator last);
+    void push_front(const T& value) { insert_after(before_begin(), value); }
+    void pop_front() { erase_after(before_begin()); }
+    iterator erase_after(iterator pos);
+    iterator erase_after(iterator pos, iterator last);
+    void clear() { erase_after(before_begin(), end()); }
+    void splice_after(iterator pos, forward_list& x);
+    void splice_after(iterator pos, forward_list& x, iterator i);
+    void splice_after(iterator pos, forward_list& x, iterator first, iterator last);
+    void remove(const T& value);
+    void reverse();
+    void merge(forward_list& x) { merge(x, std::less<T>()); }
+    template <typename Compare>
+    void merge(forward_list& x, Compare comp);
+    void sort() { sort(std::less<T>()); }
+    template <typename Compare>
+    void sort(Compare comp);
+};  // class forward_list
+
+/* forward_list 类的辅助函数实现 */
+
+template <typename T, typename Alloc>
+typename forward_list<T, Alloc>::link_type forward_list<T, Alloc>::create_node(
+    const T& value) {
+    link_type ptr = get_node();
+    try {
+        mystl::construct(&ptr->data, value);
+    } catch (...) {
+        put_node(ptr);
+        throw;
+    }
+    return ptr;
+}
+
+template <typename T, typename Alloc>
+void forward_list<T, Alloc>::destroy_node(link_type ptr) {
+    mystl::destroy(&ptr->data);
+    put_node(ptr);
+}
+
+template <typename T, typename Alloc>
+void forward_list<T, Alloc>::transfer_after(base_ptr pos,
+                                            base_ptr before_first,
+                                            base_ptr before_last) {
+    if (pos != before_first && pos != before_last) {
+        base_ptr first = before_first->next;
+        base_ptr after = pos->next;
+        before_first->next = before_last->next;
+        pos->next = first;
+        before_last->next = after;
+    }
+}
+
+/* forward_list 类公开成员函数的实现 */
+
+template <typename T, typename Alloc>
+typename forward_list<T, Alloc>::iterator forward_list<T, Alloc>::insert_after(
+    iterator pos,
+    const T& value) {
+    link_type tmp = create_node(value);
+    tmp->next = pos.node->next;
+    pos.node->next = tmp;
+    return base_ptr(tmp);
+}
+
+template <typename T, typename Alloc>
+void forward_list<T, Alloc>::insert_after(iterator pos,
+                                          size_type n,
+                                          const T& value) {
+    for (; n > 0; --n)
+        pos = insert_after(pos, value);
+}
+
+template <typename T, typename Alloc>
+template <typename InputIterator>
+void forward_list<T, Alloc>::insert_after(iterator pos,
+                                          InputIterator first,
+                                          InputIterator last) {
+    for (; first != last; ++first)
+        pos = insert_after(pos, *first);
+}
+
+template <typename T, typename Alloc>
+typename forward_list<T, Alloc>::iterator forward_list<T, Alloc>::erase_after(
+    iterator pos) {
+    link_type next = static_cast<link_type>(pos.node->next);
+    pos.node->next = next->next;
+    destroy_node(next);
+    return pos.node->next;
+}
+
+// 删除 (pos, last) 中的元素
+template <typename T, typename Alloc>
+typename forward_list<T, Alloc>::iterator forward_list<T, Alloc>::erase_after(
+    iterator pos,
+    iterator last) {
+    base_ptr cur = pos.node->next;
+    while (cur != last.node) {
+        base_ptr next = cur->next;
+        destroy_node(static_cast<link_type>(cur));
+        cur = next;
+    }
+    pos.node->next = last.node;
+    return last;
+}
+
+template <typename T, typename Alloc>
+void forward_list<T, Alloc>::splice_after(iterator pos, forward_list& x) {
+    if (x.empty())
+        return;
+    base_ptr before_last = x.before_head();
+    while (before_last->next != 0)
+        before_last = before_last->next;
+    transfer_after(pos.node, x.before_head(), before_last);
+}
+
+// 把 i 之后的那个元素移动到 pos 之后
+template <typename T, typename Alloc>
+void forward_list<T, Alloc>::splice_after(iterator pos,
+                                          forward_list&,
+                                          iterator i) {
+    if (i.node->next != 0)
+        transfer_after(pos.node, i.node, i.node->next);
+}
+
+// 把 (first, last) 中的元素移动到 pos 之后
+template <typename T, typename Alloc>
+void forward_list<T, Alloc>::splice_after(iterator pos,
+                                          forward_list&,
+                                          iterator first,
+                                          iterator last) {
+    if (first == last || first.node->next == last.node)
+        return;
+    base_ptr before_last = first.node;
+    while (before_last->next != last.node)
+        before_last = before_last->next;
+    transfer_after(pos.node, first.node, before_last);
+}
+
+template <typename T, typename Alloc>
+void forward_list<T, Alloc>::remove(const T& value) {
+    base_ptr prev = before_head();
+    while (prev->next != 0) {
+        if (static_cast<link_type>(prev->next)->data == value)
+            erase_after(prev);
+        else
+            prev = prev->next;
+    }
+}
+
+template <typename T, typename Alloc>
+void forward_list<T, Alloc>::reverse() {
+    base_ptr result = 0;
+    base_ptr cur = head.next;
+    while (cur != 0) {
+        base_ptr next = cur->next;
+        cur->next = result;
+        result = cur;
+        cur = next;
+    }
+    head.next = result;
+}
+
+// 两个链表均应已按 comp 排好序，相等时 *this 中的元素在前
+template <typename T, typename Alloc>
+template <typename Compare>
+void forward_list<T, Alloc>::merge(forward_list& x, Compare comp) {
+    if (&x == this)
+        return;
+    base_ptr prev = before_head();
+    while (prev->next != 0 && x.head.next != 0) {
+        if (comp(static_cast<link_type>(x.head.next)->data,
+                 static_cast<link_type>(prev->next)->data))
+            transfer_after(prev, x.before_head(), x.head.next);
+        prev = prev->next;
+    }
+    if (x.head.next != 0) {
+        prev->next = x.head.next;
+        x.head.next = 0;
+    }
+}
+
+// 与 list::sort 相同，收集节点指针到连续数组中排序后再重新链接
+template <typename T, typename Alloc>
+template <typename Compare>
+void forward_list<T, Alloc>::sort(Compare comp) {
+    if (head.next == 0 || head.next->next == 0)
+        return;
+    using ptr_alloc = typename Alloc::template rebind<link_type>::other;
+    const size_type n = size();
+    link_type* links = ptr_alloc::allocate(2 * n);
+    try {
+        base_ptr cur = head.next;
+        for (size_type i = 0; i != n; ++i, cur = cur->next)
+            links[i] = static_cast<link_type>(cur);
+        sort_links(links, links + n, n, comp);
+    } catch (...) {
+        ptr_alloc::deallocate(links, 2 * n);
+        throw;
+    }
+    base_ptr prev = before_head();
+    for (size_type i = 0; i != n; ++i) {
+        prev->next = links[i];
+        prev = links[i];
+    }
+    prev->next = 0;
+    ptr_alloc::deallocate(links, 2 * n);
+}
+
+template <typename T, typename Alloc>
+inline bool operator==(const forward_list<T, Alloc>& lhs,
+                       const forward_list<T, Alloc>& rhs) {
+    auto first1 = lhs.begin();
+    auto first2 = rhs.begin();
+    for (; first1 != lhs.end() && first2 != rhs.end(); ++first1, ++first2)
+        if (*first1 != *first2)
+            return false;
+    return first1 == lhs.end() && first2 == rhs.end();
+}
+
+template <typename T, typename Alloc>
+inline void swap(forward_list<T, Alloc>& lhs, forward_list<T, Alloc>& rhs) {
+    lhs.swap(rhs);
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_FORWARD_LIST_H_
@@ -0,0 +1,112 @@
+#if !defined(MYSTL_HASH_MAP_H_)
+#define MYSTL_HASH_MAP_H_
+
+#include <functional>
+#include <utility>
+#include "hashtable.h"
+
+namespace mystl {
+// 以开链 hashtable 为底层容器，元素为 pair<const Key, T>，
+// 元素地址在重新散列后保持不变，operator[] 返回的引用可以长期持有
+template <typename Key, typename T, typename HashFcn = std::hash<Key>,
+          typename EqualKey = std::equal_to<Key>>
+class hash_map {
+private:
+    using rep_type = hashtable<std::pair<const Key, T>, Key, HashFcn,
+                               std::_Select1st<std::pair<const Key, T>>,
+                               EqualKey>;
+    rep_type rep;
+
+public:
+    using key_type          = typename rep_type::key_type;
+    using data_type         = T;
+    using mapped_type       = T;
+    using value_type        = typename rep_type::value_type;
+    using hasher            = typename rep_type::hasher;
+    using key_equal         = typename rep_type::key_equal;
+
+    using size_type         = typename rep_type::size_type;
+    using difference_type   = typename rep_type::difference_type;
+    using pointer           = typename rep_type::pointer;
+    using const_pointer     = typename rep_type::const_pointer;
+    using reference         = typename rep_type::reference;
+    using const_reference   = typename rep_type::const_reference;
+    using iterator          = typename rep_type::iterator;
+    using const_iterator    = typename rep_type::const_iterator;
+
+    // 构造函数，n 为预期的元素个数，桶数取不小于 n 的质数
+    hash_map() : rep(100, hasher(), key_equal()) {}
+    explicit hash_map(size_type n) : rep(n, hasher(), key_equal()) {}
+    hash_map(size_type n, const hasher& hf) : rep(n, hf, key_equal()) {}
+    hash_map(size_type n, const hasher& hf, const key_equal& eql)
+        : rep(n, hf, eql) {}
+    template <typename InputIterator>
+    hash_map(InputIterator first, InputIterator last)
+        : rep(100, hasher(), key_equal()) {
+        rep.insert_unique(first, last);
+    }
+    template <typename InputIterator>
+    hash_map(InputIterator first, InputIterator last, size_type n)
+        : rep(n, hasher(), key_equal()) {
+        rep.insert_unique(first, last);
+    }
+
+    hasher          hash_funct()    const { return rep.hash_funct(); }
+    key_equal       key_eq()        const { return rep.key_eq(); }
+    iterator        begin()               { return rep.begin(); }
+    const_iterator  begin()         const { return rep.begin(); }
+    iterator        end()                 { return rep.end(); }
+    const_iterator  end()           const { return rep.end(); }
+    bool            empty()         const { return rep.empty(); }
+    size_type       size()          const { return rep.size(); }
+    size_type       max_size()      const { return rep.max_size(); }
+    void            swap(hash_map& hs) { rep.swap(hs.rep); }
+
+    T& operator[](const key_type& key) {
+        return rep.find_or_insert(value_type(key, T())).second;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& obj) {
+        return rep.insert_unique(obj);
+    }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        rep.insert_unique(first, last);
+    }
+    std::pair<iterator, bool> insert_noresize(const value_type& obj) {
+        return rep.insert_unique_noresize(obj);
+    }
+
+    iterator find(const key_type& key) { return rep.find(key); }
+    const_iterator find(const key_type& key) const { return rep.find(key); }
+    size_type count(const key_type& key) const { return rep.count(key); }
+    std::pair<iterator, iterator> equal_range(const key_type& key) {
+        return rep.equal_range(key);
+    }
+    std::pair<const_iterator, const_iterator> equal_range(
+        const key_type& key) const {
+        return rep.equal_range(key);
+    }
+
+    size_type erase(const key_type& key) { return rep.erase(key); }
+    void erase(iterator it) { rep.erase(it); }
+    void erase(iterator first, iterator last) { rep.erase(first, last); }
+    void clear() { rep.clear(); }
+    void release_free_nodes() { rep.release_free_nodes(); }
+
+    void resize(size_type hint) { rep.resize(hint); }
+    size_type bucket_count() const { return rep.bucket_count(); }
+    size_type max_bucket_count() const { return rep.max_bucket_count(); }
+    size_type elems_in_bucket(size_type n) const {
+        return rep.elems_in_bucket(n);
+    }
+};  // class hash_map
+
+template <typename Key, typename T, typename HashFcn, typename EqualKey>
+inline void swap(hash_map<Key, T, HashFcn, EqualKey>& lhs,
+                 hash_map<Key, T, HashFcn, EqualKey>& rhs) {
+    lhs.swap(rhs);
+}
+}  // namespace mystl
+
+#endif  // MYSTL_HASH_MAP_H_
@@ -0,0 +1,184 @@
+#if !defined(MYSTL_HASH_SET_H_)
+#define MYSTL_HASH_SET_H_
+
+#include <functional>
+#include "hashtable.h"
+
+namespace mystl {
+// 以开链 hashtable 为底层容器，元素地址在重新散列后保持不变
+template <typename Value, typename HashFcn = std::hash<Value>,
+          typename EqualKey = std::equal_to<Value>>
+class hash_set {
+private:
+    using rep_type =
+        hashtable<Value, Value, HashFcn, std::_Identity<Value>, EqualKey>;
+    rep_type rep;
+
+public:
+    using key_type          = typename rep_type::key_type;
+    using value_type        = typename rep_type::value_type;
+    using hasher            = typename rep_type::hasher;
+    using key_equal         = typename rep_type::key_equal;
+
+    using size_type         = typename rep_type::size_type;
+    using difference_type   = typename rep_type::difference_type;
+    using pointer           = typename rep_type::const_pointer;
+    using const_pointer     = typename rep_type::const_pointer;
+    using reference         = typename rep_type::const_reference;
+    using const_reference   = typename rep_type::const_reference;
+    using iterator          = typename rep_type::const_iterator;
+    using const_iterator    = typename rep_type::const_iterator;
+
+    // 构造函数，n 为预期的元素个数，桶数取不小于 n 的质数
+    hash_set() : rep(100, hasher(), key_equal()) {}
+    explicit hash_set(size_type n) : rep(n, hasher(), key_equal()) {}
+    hash_set(size_type n, const hasher& hf) : rep(n, hf, key_equal()) {}
+    hash_set(size_type n, const hasher& hf, const key_equal& eql)
+        : rep(n, hf, eql) {}
+    template <typename InputIterator>
+    hash_set(InputIterator first, InputIterator last)
+        : rep(100, hasher(), key_equal()) {
+        rep.insert_unique(first, last);
+    }
+    template <typename InputIterator>
+    hash_set(InputIterator first, InputIterator last, size_type n)
+        : rep(n, hasher(), key_equal()) {
+        rep.insert_unique(first, last);
+    }
+
+    hasher          hash_funct()    const { return rep.hash_funct(); }
+    key_equal       key_eq()        const { return rep.key_eq(); }
+    iterator        begin()         const { return rep.begin(); }
+    iterator        end()           const { return rep.end(); }
+    bool            empty()         const { return rep.empty(); }
+    size_type       size()          const { return rep.size(); }
+    size_type       max_size()      const { return rep.max_size(); }
+    void            swap(hash_set& hs) { rep.swap(hs.rep); }
+
+    std::pair<iterator, bool> insert(const value_type& obj) {
+        std::pair<typename rep_type::iterator, bool> p = rep.insert_unique(obj);
+        return std::pair<iterator, bool>(p.first, p.second);
+    }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        rep.insert_unique(first, last);
+    }
+    std::pair<iterator, bool> insert_noresize(const value_type& obj) {
+        std::pair<typename rep_type::iterator, bool> p =
+            rep.insert_unique_noresize(obj);
+        return std::pair<iterator, bool>(p.first, p.second);
+    }
+
+    iterator find(const key_type& key) const { return rep.find(key); }
+    size_type count(const key_type& key) const { return rep.count(key); }
+    std::pair<iterator, iterator> equal_range(const key_type& key) const {
+        return rep.equal_range(key);
+    }
+
+    size_type erase(const key_type& key) { return rep.erase(key); }
+    void erase(iterator it) { rep.erase(it); }
+    void erase(iterator first, iterator last) { rep.erase(first, last); }
+    void clear() { rep.clear(); }
+    void release_free_nodes() { rep.release_free_nodes(); }
+
+    void resize(size_type hint) { rep.resize(hint); }
+    size_type bucket_count() const { return rep.bucket_count(); }
+    size_type max_bucket_count() const { return rep.max_bucket_count(); }
+    size_type elems_in_bucket(size_type n) const {
+        return rep.elems_in_bucket(n);
+    }
+};  // class hash_set
+
+template <typename Value, typename HashFcn, typename EqualKey>
+inline void swap(hash_set<Value, HashFcn, EqualKey>& lhs,
+                 hash_set<Value, HashFcn, EqualKey>& rhs) {
+    lhs.swap(rhs);
+}
+
+// 允许元素重复的 hash_set，相等的元素在桶内相邻
+template <typename Value, typename HashFcn = std::hash<Value>,
+          typename EqualKey = std::equal_to<Value>>
+class hash_multiset {
+private:
+    using rep_type =
+        hashtable<Value, Value, HashFcn, std::_Identity<Value>, EqualKey>;
+    rep_type rep;
+
+public:
+    using key_type          = typename rep_type::key_type;
+    using value_type        = typename rep_type::value_type;
+    using hasher            = typename rep_type::hasher;
+    using key_equal         = typename rep_type::key_equal;
+
+    using size_type         = typename rep_type::size_type;
+    using difference_type   = typename rep_type::difference_type;
+    using pointer           = typename rep_type::const_pointer;
+    using const_pointer     = typename rep_type::const_pointer;
+    using reference         = typename rep_type::const_reference;
+    using const_reference   = typename rep_type::const_reference;
+    using iterator          = typename rep_type::const_iterator;
+    using const_iterator    = typename rep_type::const_iterator;
+
+    // 构造函数
+    hash_multiset() : rep(100, hasher(), key_equal()) {}
+    explicit hash_multiset(size_type n) : rep(n, hasher(), key_equal()) {}
+    hash_multiset(size_type n, const hasher& hf) : rep(n, hf, key_equal()) {}
+    hash_multiset(size_type n, const hasher& hf, const key_equal& eql)
+        : rep(n, hf, eql) {}
+    template <typename InputIterator>
+    hash_multiset(InputIterator first, InputIterator last)
+        : rep(100, hasher(), key_equal()) {
+        rep.insert_equal(first, last);
+    }
+    template <typename InputIterator>
+    hash_multiset(InputIterator first, InputIterator last, size_type n)
+        : rep(n, hasher(), key_equal()) {
+        rep.insert_equal(first, last);
+    }
+
+    hasher          hash_funct()    const { return rep.hash_funct(); }
+    key_equal       key_eq()        const { return rep.key_eq(); }
+    iterator        begin()         const { return rep.begin(); }
+    iterator        end()           const { return rep.end(); }
+    bool            empty()         const { return rep.empty(); }
+    size_type       size()          const { return rep.size(); }
+    size_type       max_size()      const { return rep.max_size(); }
+    void            swap(hash_multiset& hs) { rep.swap(hs.rep); }
+
+    iterator insert(const value_type& obj) { return rep.insert_equal(obj); }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        rep.insert_equal(first, last);
+    }
+    iterator insert_noresize(const value_type& obj) {
+        return rep.insert_equal_noresize(obj);
+    }
+
+    iterator find(const key_type& key) const { return rep.find(key); }
+    size_type count(const key_type& key) const { return rep.count(key); }
+    std::pair<iterator, iterator> equal_range(const key_type& key) const {
+        return rep.equal_range(key);
+    }
+
+    size_type erase(const key_type& key) { return rep.erase(key); }
+    void erase(iterator it) { rep.erase(it); }
+    void erase(iterator first, iterator last) { rep.erase(first, last); }
+    void clear() { rep.clear(); }
+    void release_free_nodes() { rep.release_free_nodes(); }
+
+    void resize(size_type hint) { rep.resize(hint); }
+    size_type bucket_count() const { return rep.bucket_count(); }
+    size_type max_bucket_count() const { return rep.max_bucket_count(); }
+    size_type elems_in_bucket(size_type n) const {
+        return rep.elems_in_bucket(n);
+    }
+};  // class hash_multiset
+
+template <typename Value, typename HashFcn, typename EqualKey>
+inline void swap(hash_multiset<Value, HashFcn, EqualKey>& lhs,
+                 hash_multiset<Value, HashFcn, EqualKey>& rhs) {
+    lhs.swap(rhs);
+}
+}  // namespace mystl
+
+#endif  // MYSTL_HASH_SET_H_
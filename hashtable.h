@@ -0,0 +1,554 @@
+#if !defined(MYSTL_HASHTABLE_H_)
+#define MYSTL_HASHTABLE_H_
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include "memory.h"
+#include "vector.h"
+
+/* 本头文件实现了 SGI 风格的开链哈希表，桶数组为 vector<node*>，桶数取质数
+ * 元素存放在各自的节点中，重新散列只移动节点指针，因此元素的地址始终不变，
+ * 这一点是开放寻址的 swiss_table 做不到的
+ * 被删除的节点不立即归还分配器，而是挂到表内的空闲链表上供下次插入复用 */
+namespace mystl {
+
+template <typename Value>
+struct hashtable_node {
+    hashtable_node* next;
+    Value val;
+};
+
+template <typename Value, typename Key, typename HashFcn, typename ExtractKey,
+          typename EqualKey>
+class hashtable;
+
+template <typename Value, typename Key, typename HashFcn, typename ExtractKey,
+          typename EqualKey, typename Ref, typename Ptr>
+struct hashtable_iterator {
+    using hashtable_type =
+        hashtable<Value, Key, HashFcn, ExtractKey, EqualKey>;
+    using iterator = hashtable_iterator<Value, Key, HashFcn, ExtractKey,
+                                        EqualKey, Value&, Value*>;
+    using self = hashtable_iterator<Value, Key, HashFcn, ExtractKey,
+                                    EqualKey, Ref, Ptr>;
+    using node              = hashtable_node<Value>;
+
+    using iterator_category = forward_iterator_tag;
+    using value_type        = Value;
+    using difference_type   = ptrdiff_t;
+    using size_type         = size_t;
+    using reference         = Ref;
+    using pointer           = Ptr;
+
+    node* cur;
+    const hashtable_type* ht;
+
+    hashtable_iterator() : cur(0), ht(0) {}
+    hashtable_iterator(node* n, const hashtable_type* tab) : cur(n), ht(tab) {}
+    template <typename Iter, typename = typename std::enable_if<
+                                 std::is_same<Iter, iterator>::value>::type>
+    hashtable_iterator(const Iter& it) : cur(it.cur), ht(it.ht) {}
+
+    reference operator*() const { return cur->val; }
+    pointer operator->() const { return &(operator*()); }
+    self& operator++();
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    bool operator==(const self& it) const { return cur == it.cur; }
+    bool operator!=(const self& it) const { return cur != it.cur; }
+};
+
+// 桶数取自这张质数表，每次约翻倍
+enum { num_primes = 28 };
+
+static const unsigned long prime_list[num_primes] = {
+    53ul,         97ul,         193ul,       389ul,       769ul,
+    1543ul,       3079ul,       6151ul,      12289ul,     24593ul,
+    49157ul,      98317ul,      196613ul,    393241ul,    786433ul,
+    1572869ul,    3145739ul,    6291469ul,   12582917ul,  25165843ul,
+    50331653ul,   100663319ul,  201326611ul, 402653189ul, 805306457ul,
+    1610612741ul, 3221225473ul, 4294967291ul};
+
+// 不小于 n 的最小质数
+inline unsigned long next_prime(unsigned long n) {
+    const unsigned long* first = prime_list;
+    const unsigned long* last = prime_list + num_primes;
+    const unsigned long* pos = std::lower_bound(first, last, n);
+    return pos == last ? *(last - 1) : *pos;
+}
+
+template <typename Value, typename Key, typename HashFcn, typename ExtractKey,
+          typename EqualKey>
+class hashtable {
+public:
+    using key_type          = Key;
+    using value_type        = Value;
+    using hasher            = HashFcn;
+    using key_equal         = EqualKey;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    using pointer           = value_type*;
+    using const_pointer     = const value_type*;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+    using iterator = hashtable_iterator<Value, Key, HashFcn, ExtractKey,
+                                        EqualKey, Value&, Value*>;
+    using const_iterator =
+        hashtable_iterator<Value, Key, HashFcn, ExtractKey, EqualKey,
+                           const Value&, const Value*>;
+
+    friend iterator;
+    friend const_iterator;
+
+private:
+    using node          = hashtable_node<Value>;
+    using node_alloc    = alloc<node>;
+
+    hasher hash;
+    key_equal equals;
+    ExtractKey get_key;
+    vector<node*> buckets;
+    size_type num_elements;
+    node* free_nodes;  // 已析构元素、尚未归还分配器的节点
+
+public:
+    hashtable(size_type n, const HashFcn& hf, const EqualKey& eql)
+        : hash(hf), equals(eql), get_key(ExtractKey()), num_elements(0),
+          free_nodes(0) {
+        initialize_buckets(n);
+    }
+    hashtable(const hashtable& ht)
+        : hash(ht.hash), equals(ht.equals), get_key(ht.get_key),
+          num_elements(0), free_nodes(0) {
+        copy_from(ht);
+    }
+    hashtable& operator=(const hashtable& ht) {
+        if (&ht != this) {
+            clear();
+            hash = ht.hash;
+            equals = ht.equals;
+            get_key = ht.get_key;
+            copy_from(ht);
+        }
+        return *this;
+    }
+    ~hashtable() {
+        clear();
+        release_free_nodes();
+    }
+
+    size_type size() const { return num_elements; }
+    size_type max_size() const { return size_type(-1); }
+    bool empty() const { return size() == 0; }
+    hasher hash_funct() const { return hash; }
+    key_equal key_eq() const { return equals; }
+
+    void swap(hashtable& ht) {
+        std::swap(hash, ht.hash);
+        std::swap(equals, ht.equals);
+        std::swap(get_key, ht.get_key);
+        buckets.swap(ht.buckets);
+        std::swap(num_elements, ht.num_elements);
+        std::swap(free_nodes, ht.free_nodes);
+    }
+
+    iterator begin() {
+        for (size_type n = 0; n < buckets.size(); ++n)
+            if (buckets[n])
+                return iterator(buckets[n], this);
+        return end();
+    }
+    iterator end() { return iterator(0, this); }
+    const_iterator begin() const {
+        return const_cast<hashtable*>(this)->begin();
+    }
+    const_iterator end() const { return const_iterator(0, this); }
+
+    size_type bucket_count() const { return buckets.size(); }
+    size_type max_bucket_count() const { return prime_list[num_primes - 1]; }
+    size_type elems_in_bucket(size_type bucket) const {
+        size_type result = 0;
+        for (node* cur = buckets[bucket]; cur; cur = cur->next)
+            ++result;
+        return result;
+    }
+
+    std::pair<iterator, bool> insert_unique(const value_type& obj) {
+        resize(num_elements + 1);
+        return insert_unique_noresize(obj);
+    }
+    iterator insert_equal(const value_type& obj) {
+        resize(num_elements + 1);
+        return insert_equal_noresize(obj);
+    }
+    std::pair<iterator, bool> insert_unique_noresize(const value_type& obj);
+    iterator insert_equal_noresize(const value_type& obj);
+
+    template <typename InputIterator>
+    void insert_unique(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert_unique(*first);
+    }
+    template <typename InputIterator>
+    void insert_equal(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert_equal(*first);
+    }
+
+    // 键不存在时插入 obj，返回表中元素的引用，供 hash_map::operator[] 使用
+    reference find_or_insert(const value_type& obj);
+
+    iterator find(const key_type& key) {
+        size_type n = bkt_num_key(key);
+        node* first = buckets[n];
+        while (first && !equals(get_key(first->val), key))
+            first = first->next;
+        return iterator(first, this);
+    }
+    const_iterator find(const key_type& key) const {
+        return const_cast<hashtable*>(this)->find(key);
+    }
+    size_type count(const key_type& key) const {
+        const size_type n = bkt_num_key(key);
+        size_type result = 0;
+        for (const node* cur = buckets[n]; cur; cur = cur->next)
+            if (equals(get_key(cur->val), key))
+                ++result;
+        return result;
+    }
+    std::pair<iterator, iterator> equal_range(const key_type& key);
+    std::pair<const_iterator, const_iterator> equal_range(
+        const key_type& key) const {
+        std::pair<iterator, iterator> p =
+            const_cast<hashtable*>(this)->equal_range(key);
+        return std::pair<const_iterator, const_iterator>(p.first, p.second);
+    }
+
+    size_type erase(const key_type& key);
+    void erase(const const_iterator& it);
+    void erase(const_iterator first, const_iterator last);
+
+    // 桶数不足以使负载因子不超过 1 时扩充为下一个质数，节点原地重新挂接
+    void resize(size_type num_elements_hint);
+    void clear();
+    // 把空闲链表中的节点归还分配器
+    void release_free_nodes() {
+        while (free_nodes) {
+            node* next = free_nodes->next;
+            node_alloc::deallocate(free_nodes);
+            free_nodes = next;
+        }
+    }
+
+private:
+    size_type next_size(size_type n) const { return next_prime(n); }
+
+    void initialize_buckets(size_type n) {
+        vector<node*> tmp(next_size(n), (node*)0);
+        buckets.swap(tmp);
+        num_elements = 0;
+    }
+
+    size_type bkt_num_key(const key_type& key) const {
+        return bkt_num_key(key, buckets.size());
+    }
+    size_type bkt_num(const value_type& obj) const {
+        return bkt_num_key(get_key(obj));
+    }
+    size_type bkt_num_key(const key_type& key, size_t n) const {
+        return hash(key) % n;
+    }
+    size_type bkt_num(const value_type& obj, size_t n) const {
+        return bkt_num_key(get_key(obj), n);
+    }
+
+    // 优先复用空闲链表中的节点
+    node* new_node(const value_type& obj) {
+        node* n;
+        if (free_nodes) {
+            n = free_nodes;
+            free_nodes = free_nodes->next;
+        } else {
+            n = node_alloc::allocate();
+        }
+        try {
+            mystl::construct(&n->val, obj);
+        } catch (...) {
+            n->next = free_nodes;
+            free_nodes = n;
+            throw;
+        }
+        n->next = 0;
+        return n;
+    }
+    void delete_node(node* n) {
+        mystl::destroy(&n->val);
+        n->next = free_nodes;
+        free_nodes = n;
+    }
+
+    void erase_bucket(size_type n, node* first, node* last);
+    void erase_bucket(size_type n, node* last);
+    void copy_from(const hashtable& ht);
+};
+
+template <typename V, typename K, typename HF, typename ExK, typename EqK,
+          typename Ref, typename Ptr>
+hashtable_iterator<V, K, HF, ExK, EqK, Ref, Ptr>&
+hashtable_iterator<V, K, HF, ExK, EqK, Ref, Ptr>::operator++() {
+    const node* old = cur;
+    cur = cur->next;
+    if (!cur) {
+        size_type bucket = ht->bkt_num(old->val);
+        while (!cur && ++bucket < ht->buckets.size())
+            cur = ht->buckets[bucket];
+    }
+    return *this;
+}
+
+template <typename V, typename K, typename HF, typename ExK, typename EqK>
+std::pair<typename hashtable<V, K, HF, ExK, EqK>::iterator, bool>
+hashtable<V, K, HF, ExK, EqK>::insert_unique_noresize(const value_type& obj) {
+    const size_type n = bkt_num(obj);
+    node* first = buckets[n];
+    for (node* cur = first; cur; cur = cur->next)
+        if (equals(get_key(cur->val), get_key(obj)))
+            return std::pair<iterator, bool>(iterator(cur, this), false);
+    node* tmp = new_node(obj);
+    tmp->next = first;
+    buckets[n] = tmp;
+    ++num_elements;
+    return std::pair<iterator, bool>(iterator(tmp, this), true);
+}
+
+// 相等的元素插在一起，使 equal_range 得到连续区间
+template <typename V, typename K, typename HF, typename ExK, typename EqK>
+typename hashtable<V, K, HF, ExK, EqK>::iterator
+hashtable<V, K, HF, ExK, EqK>::insert_equal_noresize(const value_type& obj) {
+    const size_type n = bkt_num(obj);
+    node* first = buckets[n];
+    for (node* cur = first; cur; cur = cur->next)
+        if (equals(get_key(cur->val), get_key(obj))) {
+            node* tmp = new_node(obj);
+            tmp->next = cur->next;
+            cur->next = tmp;
+            ++num_elements;
+            return iterator(tmp, this);
+        }
+    node* tmp = new_node(obj);
+    tmp->next = first;
+    buckets[n] = tmp;
+    ++num_elements;
+    return iterator(tmp, this);
+}
+
+template <typename V, typename K, typename HF, typename ExK, typename EqK>
+typename hashtable<V, K, HF, ExK, EqK>::reference
+hashtable<V, K, HF, ExK, EqK>::find_or_insert(const value_type& obj) {
+    resize(num_elements + 1);
+    size_type n = bkt_num(obj);
+    node* first = buckets[n];
+    for (node* cur = first; cur; cur = cur->next)
+        if (equals(get_key(cur->val), get_key(obj)))
+            return cur->val;
+    node* tmp = new_node(obj);
+    tmp->next = first;
+    buckets[n] = tmp;
+    ++num_elements;
+    return tmp->val;
+}
+
+template <typename V, typename K, typename HF, typename ExK, typename EqK>
+std::pair<typename hashtable<V, K, HF, ExK, EqK>::iterator,
+          typename hashtable<V, K, HF, ExK, EqK>::iterator>
+hashtable<V, K, HF, ExK, EqK>::equal_range(const key_type& key) {
+    using pii = std::pair<iterator, iterator>;
+    const size_type n = bkt_num_key(key);
+    for (node* first = buckets[n]; first; first = first->next)
+        if (equals(get_key(first->val), key)) {
+            for (node* cur = first->next; cur; cur = cur->next)
+                if (!equals(get_key(cur->val), key))
+                    return pii(iterator(first, this), iterator(cur, this));
+            for (size_type m = n + 1; m < buckets.size(); ++m)
+                if (buckets[m])
+                    return pii(iterator(first, this),
+                               iterator(buckets[m], this));
+            return pii(iterator(first, this), end());
+        }
+    return pii(end(), end());
+}
+
+template <typename V, typename K, typename HF, typename ExK, typename EqK>
+typename hashtable<V, K, HF, ExK, EqK>::size_type
+hashtable<V, K, HF, ExK, EqK>::erase(const key_type& key) {
+    const size_type n = bkt_num_key(key);
+    node* first = buckets[n];
+    size_type erased = 0;
+    if (first) {
+        node* cur = first;
+        node* next = cur->next;
+        while (next) {
+            if (equals(get_key(next->val), key)) {
+                cur->next = next->next;
+                delete_node(next);
+                next = cur->next;
+                ++erased;
+                --num_elements;
+            } else {
+                cur = next;
+                next = cur->next;
+            }
+        }
+        if (equals(get_key(first->val), key)) {
+            buckets[n] = first->next;
+            delete_node(first);
+            ++erased;
+            --num_elements;
+        }
+    }
+    return erased;
+}
+
+template <typename V, typename K, typename HF, typename ExK, typename EqK>
+void hashtable<V, K, HF, ExK, EqK>::erase(const const_iterator& it) {
+    node* p = it.cur;
+    if (p) {
+        const size_type n = bkt_num(p->val);
+        node* cur = buckets[n];
+        if (cur == p) {
+            buckets[n] = cur->next;
+            delete_node(cur);
+            --num_elements;
+        } else {
+            node* next = cur->next;
+            while (next) {
+                if (next == p) {
+                    cur->next = next->next;
+                    delete_node(next);
+                    --num_elements;
+                    break;
+                } else {
+                    cur = next;
+                    next = cur->next;
+                }
+            }
+        }
+    }
+}
+
+template <typename V, typename K, typename HF, typename ExK, typename EqK>
+void hashtable<V, K, HF, ExK, EqK>::erase(const_iterator first,
+                                          const_iterator last) {
+    size_type f_bucket =
+        first.cur ? bkt_num(first.cur->val) : buckets.size();
+    size_type l_bucket = last.cur ? bkt_num(last.cur->val) : buckets.size();
+    if (first.cur == last.cur)
+        return;
+    else if (f_bucket == l_bucket)
+        erase_bucket(f_bucket, first.cur, last.cur);
+    else {
+        erase_bucket(f_bucket, first.cur, 0);
+        for (size_type n = f_bucket + 1; n < l_bucket; ++n)
+            erase_bucket(n, 0);
+        if (l_bucket != buckets.size())
+            erase_bucket(l_bucket, last.cur);
+    }
+}
+
+template <typename V, typename K, typename HF, typename ExK, typename EqK>
+void hashtable<V, K, HF, ExK, EqK>::resize(size_type num_elements_hint) {
+    const size_type old_n = buckets.size();
+    if (num_elements_hint > old_n) {
+        const size_type n = next_size(num_elements_hint);
+        if (n > old_n) {
+            vector<node*> tmp(n, (node*)0);
+            for (size_type bucket = 0; bucket < old_n; ++bucket) {
+                node* first = buckets[bucket];
+                while (first) {
+                    size_type new_bucket = bkt_num(first->val, n);
+                    buckets[bucket] = first->next;
+                    first->next = tmp[new_bucket];
+                    tmp[new_bucket] = first;
+                    first = buckets[bucket];
+                }
+            }
+            buckets.swap(tmp);
+        }
+    }
+}
+
+template <typename V, typename K, typename HF, typename ExK, typename EqK>
+void hashtable<V, K, HF, ExK, EqK>::erase_bucket(size_type n, node* first,
+                                                 node* last) {
+    node* cur = buckets[n];
+    if (cur == first)
+        erase_bucket(n, last);
+    else {
+        node* next;
+        for (next = cur->next; next != first; cur = next, next = cur->next)
+            ;
+        while (next != last) {
+            cur->next = next->next;
+            delete_node(next);
+            next = cur->next;
+            --num_elements;
+        }
+    }
+}
+
+template <typename V, typename K, typename HF, typename ExK, typename EqK>
+void hashtable<V, K, HF, ExK, EqK>::erase_bucket(size_type n, node* last) {
+    node* cur = buckets[n];
+    while (cur != last) {
+        node* next = cur->next;
+        delete_node(cur);
+        cur = next;
+        buckets[n] = cur;
+        --num_elements;
+    }
+}
+
+// 清空元素但保留桶数组，节点进入空闲链表
+template <typename V, typename K, typename HF, typename ExK, typename EqK>
+void hashtable<V, K, HF, ExK, EqK>::clear() {
+    for (size_type i = 0; i < buckets.size(); ++i) {
+        node* cur = buckets[i];
+        while (cur != 0) {
+            node* next = cur->next;
+            delete_node(cur);
+            cur = next;
+        }
+        buckets[i] = 0;
+    }
+    num_elements = 0;
+}
+
+template <typename V, typename K, typename HF, typename ExK, typename EqK>
+void hashtable<V, K, HF, ExK, EqK>::copy_from(const hashtable& ht) {
+    vector<node*> tmp(ht.buckets.size(), (node*)0);
+    buckets.swap(tmp);
+    try {
+        for (size_type i = 0; i < ht.buckets.size(); ++i) {
+            if (const node* cur = ht.buckets[i]) {
+                node* copy = new_node(cur->val);
+                buckets[i] = copy;
+                for (node* next = cur->next; next;
+                     cur = next, next = cur->next) {
+                    copy->next = new_node(next->val);
+                    copy = copy->next;
+                }
+            }
+        }
+        num_elements = ht.num_elements;
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+}  // namespace mystl
+
+#endif  // MYSTL_HASHTABLE_H_
@@ -0,0 +1,282 @@
+#if !defined(MYSTL_INTRUSIVE_LIST_H_)
+#define MYSTL_INTRUSIVE_LIST_H_
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+#include "iterator.h"
+
+/* 本头文件实现了侵入式双向链表
+ * 链接指针 list_hook 作为成员放在用户类型内部，链表只负责链接与断开，不分配也不释放内存
+ * 一个对象内放置多个 list_hook 成员，即可同时挂在多个链表上 */
+namespace mystl {
+
+struct list_hook {
+    list_hook* next;
+    list_hook* prev;
+
+    list_hook() : next(0), prev(0) {}
+    // 拷贝对象时不拷贝链接关系
+    list_hook(const list_hook&) : next(0), prev(0) {}
+    list_hook& operator=(const list_hook&) { return *this; }
+
+    bool is_linked() const { return next != 0; }
+};
+
+// 由 hook 成员的地址反推出所属对象的地址
+// 成员偏移只能在真实对象上求得：每个进入链表的 hook 都先经过 to_hook，在那里记下偏移，
+// 之后 to_value 读到的总是已记录的值。不同线程可能同时链接同类型的对象，故用原子量保存
+template <typename T, list_hook T::*Hook>
+struct intrusive_list_traits {
+    static std::atomic<size_t> hook_offset;
+
+    static T* to_value(list_hook* hook) {
+        return reinterpret_cast<T*>(
+            reinterpret_cast<char*>(hook) -
+            hook_offset.load(std::memory_order_relaxed));
+    }
+    static list_hook* to_hook(T& value) {
+        list_hook* hook = &(value.*Hook);
+        size_t offset = size_t(reinterpret_cast<char*>(hook) -
+                               reinterpret_cast<char*>(&value));
+        // 同一类型的偏移恒定，值已相同时不再写入，免得各线程反复写同一缓存行
+        if (hook_offset.load(std::memory_order_relaxed) != offset)
+            hook_offset.store(offset, std::memory_order_relaxed);
+        return hook;
+    }
+};
+
+template <typename T, list_hook T::*Hook>
+std::atomic<size_t> intrusive_list_traits<T, Hook>::hook_offset(0);
+
+template <typename T, list_hook T::*Hook, typename Ref, typename Ptr>
+struct intrusive_list_iterator {
+    using iterator          = intrusive_list_iterator<T, Hook, T&, T*>;
+    using const_iterator    = intrusive_list_iterator<T, Hook, const T&, const T*>;
+    using self              = intrusive_list_iterator<T, Hook, Ref, Ptr>;
+
+    using iterator_category = bidirectional_iterator_tag;
+    using value_type        = T;
+    using pointer           = Ptr;
+    using reference         = Ref;
+    using difference_type   = ptrdiff_t;
+    using size_type         = size_t;
+
+    using traits            = intrusive_list_traits<T, Hook>;
+
+    list_hook* node;
+
+    intrusive_list_iterator(list_hook* x) : node(x) {}
+    intrusive_list_iterator() {}
+    // iterator 到 const_iterator 的转换，写成模板以免成为拷贝构造函数
+    template <typename Iter, typename = typename std::enable_if<
+                                 std::is_same<Iter, iterator>::value>::type>
+    intrusive_list_iterator(const Iter& x) : node(x.node) {}
+
+    bool operator==(const self& rhs) const { return node == rhs.node; }
+    bool operator!=(const self& rhs) const { return !(node == rhs.node); }
+    reference operator*() const { return *traits::to_value(node); }
+    pointer operator->() const { return &(operator*()); }
+    self& operator++() {
+        node = node->next;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator--() {
+        node = node->prev;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+};  // end struct intrusive_list_iterator
+
+template <typename T, list_hook T::*Hook>
+class intrusive_list {
+   public:
+    using value_type        = T;
+    using pointer           = T*;
+    using const_pointer     = const T*;
+    using reference         = T&;
+    using const_reference   = const T&;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+    using iterator          = intrusive_list_iterator<T, Hook, T&, T*>;
+    using const_iterator    = intrusive_list_iterator<T, Hook, const T&, const T*>;
+
+   protected:
+    using traits = intrusive_list_traits<T, Hook>;
+
+    // 头节点直接内嵌在链表对象中，同样不需要分配
+    list_hook header;
+    size_type node_count;
+
+    list_hook* node() const { return const_cast<list_hook*>(&header); }
+    void empty_init() {
+        header.next = &header;
+        header.prev = &header;
+        node_count = 0;
+    }
+    void link_before(list_hook* pos, list_hook* x) {
+        x->next = pos;
+        x->prev = pos->prev;
+        pos->prev->next = x;
+        pos->prev = x;
+        ++node_count;
+    }
+    void transfer(iterator pos, iterator first, iterator last);
+
+   public:
+    intrusive_list() { empty_init(); }
+    intrusive_list(const intrusive_list&) = delete;
+    intrusive_list& operator=(const intrusive_list&) = delete;
+    ~intrusive_list() { clear(); }
+
+    /* 迭代器相关操作 */
+    iterator begin() noexcept { return header.next; }
+    const_iterator begin() const noexcept { return header.next; }
+    iterator end() noexcept { return node(); }
+    const_iterator end() const noexcept { return node(); }
+    // 由对象直接得到指向它的迭代器，O(1)
+    iterator iterator_to(T& value) { return traits::to_hook(value); }
+
+    /* 容量相关操作 */
+    bool empty() const noexcept { return header.next == &header; }
+    size_type size() const noexcept { return node_count; }
+
+    /* 取值相关操作 */
+    reference front() { return *begin(); }
+    reference back() { return *iterator(header.prev); }
+
+    /* 修改链表操作，均不涉及内存分配 */
+    iterator insert(iterator pos, T& value) {
+        list_hook* x = traits::to_hook(value);
+        link_before(pos.node, x);
+        return x;
+    }
+    void push_front(T& value) { insert(begin(), value); }
+    void push_back(T& value) { insert(end(), value); }
+    iterator erase(iterator pos);
+    iterator erase(iterator first, iterator last) {
+        while (first != last)
+            first = erase(first);
+        return last;
+    }
+    void erase(T& value) { erase(iterator_to(value)); }
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(header.prev); }
+    void clear() { erase(begin(), end()); }
+    void swap(intrusive_list& rhs);
+    void splice(iterator pos, intrusive_list& x);
+    void splice(iterator pos, intrusive_list& x, iterator i);
+    void splice(iterator pos, intrusive_list& x, iterator first, iterator last);
+    void reverse();
+};  // class intrusive_list
+
+// 将 [first, last) 移动到 pos 之前，只修改指针，元素个数由调用者维护
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::transfer(iterator pos,
+                                       iterator first,
+                                       iterator last) {
+    if (pos != last) {
+        last.node->prev->next = pos.node;
+        first.node->prev->next = last.node;
+        pos.node->prev->next = first.node;
+        list_hook* tmp = pos.node->prev;
+        pos.node->prev = last.node->prev;
+        last.node->prev = first.node->prev;
+        first.node->prev = tmp;
+    }
+}
+
+// 断开节点并把 hook 置为未链接状态，对象本身不受影响
+template <typename T, list_hook T::*Hook>
+typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::erase(
+    iterator pos) {
+    list_hook* x = pos.node;
+    list_hook* next = x->next;
+    x->prev->next = next;
+    next->prev = x->prev;
+    x->next = 0;
+    x->prev = 0;
+    --node_count;
+    return next;
+}
+
+// 头节点内嵌在对象中，交换后需要修正首尾节点指回头节点的指针
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::swap(intrusive_list<T, Hook>& rhs) {
+    std::swap(header.next, rhs.header.next);
+    std::swap(header.prev, rhs.header.prev);
+    std::swap(node_count, rhs.node_count);
+    if (node_count == 0)
+        empty_init();
+    else
+        header.next->prev = header.prev->next = &header;
+    if (rhs.node_count == 0)
+        rhs.empty_init();
+    else
+        rhs.header.next->prev = rhs.header.prev->next = &rhs.header;
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::splice(iterator pos, intrusive_list& x) {
+    if (x.empty())
+        return;
+    transfer(pos, x.begin(), x.end());
+    node_count += x.node_count;
+    x.node_count = 0;
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::splice(iterator pos,
+                                     intrusive_list& x,
+                                     iterator i) {
+    iterator j = i;
+    ++j;
+    if (pos == i || pos == j)
+        return;
+    transfer(pos, i, j);
+    ++node_count;
+    --x.node_count;
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::splice(iterator pos,
+                                     intrusive_list& x,
+                                     iterator first,
+                                     iterator last) {
+    if (first == last)
+        return;
+    if (&x != this) {
+        size_type n = mystl::distance(first, last);
+        node_count += n;
+        x.node_count -= n;
+    }
+    transfer(pos, first, last);
+}
+
+template <typename T, list_hook T::*Hook>
+void intrusive_list<T, Hook>::reverse() {
+    if (node_count < 2)
+        return;
+    iterator first = begin();
+    iterator last = end();
+    ++first;
+    while (first != last) {
+        iterator old = first;
+        ++first;
+        transfer(begin(), old, first);
+    }
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_INTRUSIVE_LIST_H_
@@ -1,9 +1,13 @@
 #if !defined(MYSTL_LIST_H_)
 #define MYSTL_LIST_H_
 
+#include <algorithm>
+#include <functional>
 #include <initializer_list>
+#include <type_traits>
 #include "iterator.h"
 #include "memory.h"
+#include "unordered_map.h"
 
 namespace mystl {
 template <typename T>
@@ -32,11 +36,15 @@ struct list_iterator {
 
     list_iterator(link_type x) : node(x) {}
     list_iterator() {}
-    list_iterator(const iterator& x) : node(x.node) {}
+    // 允许 iterator 转为 const_iterator；写成模板后不再是拷贝构造函数，
+    // 拷贝构造与拷贝赋值都由编译器隐式生成
+    template <typename Iter, typename = typename std::enable_if<
+                                 std::is_same<Iter, iterator>::value>::type>
+    list_iterator(const Iter& x) : node(x.node) {}
 
     bool operator==(const self& rhs) const { return node == rhs.node; }
     bool operator!=(const self& rhs) const { return !(node == rhs.node); }
-    reference operator*() { return (*node).data; }
+    reference operator*() const { return (*node).data; }
     pointer operator->() const { return &(operator*()); }
     self& operator++() {
         node = (*node).next;
@@ -72,6 +80,238 @@ struct list_iterator {
     }
 };  // end struct list_iterator
 
+// 对节点指针数组 [first, first + n) 做稳定的自底向上归并排序，buf 为同样大小的辅助空间
+// 先对每 16 个元素做插入排序，再在两块连续内存间来回归并，结果保证写回 first
+// 节点类型只需要有 data 成员，list 与 forward_list 共用
+template <typename Link, typename Compare>
+void sort_links(Link* first, Link* buf, size_t n, Compare comp) {
+    const size_t run = 16;
+    for (size_t lo = 0; lo < n; lo += run) {
+        size_t hi = lo + run < n ? lo + run : n;
+        for (size_t i = lo + 1; i < hi; ++i) {
+            Link x = first[i];
+            size_t j = i;
+            for (; j > lo && comp(x->data, first[j - 1]->data); --j)
+                first[j] = first[j - 1];
+            first[j] = x;
+        }
+    }
+    Link* from = first;
+    Link* to = buf;
+    for (size_t width = run; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            size_t i = lo, j = mid, k = lo;
+            // 右侧严格小于左侧时才取右侧，保证稳定
+            while (i < mid && j < hi)
+                to[k++] = comp(from[j]->data, from[i]->data) ? from[j++]
+                                                             : from[i++];
+            while (i < mid)
+                to[k++] = from[i++];
+            while (j < hi)
+                to[k++] = from[j++];
+        }
+        std::swap(from, to);
+    }
+    if (from != first)
+        std::copy(from, from + n, first);
+}
+
+// 节点句柄，持有一个已从链表中摘下但尚未释放的节点
+// 可以再插入任何使用同一 Alloc 的 list 中，整个过程不分配内存、不复制元素
+// 句柄析构时若仍持有节点，则析构元素并释放节点
+template <typename T, typename Alloc>
+class list_node_handle {
+   public:
+    using value_type = T;
+    using link_type = list_node<T>*;
+
+    list_node_handle() : ptr(0) {}
+    explicit list_node_handle(link_type x) : ptr(x) {}
+    list_node_handle(list_node_handle&& rhs) : ptr(rhs.ptr) { rhs.ptr = 0; }
+    list_node_handle& operator=(list_node_handle&& rhs) {
+        if (this != &rhs) {
+            reset();
+            ptr = rhs.ptr;
+            rhs.ptr = 0;
+        }
+        return *this;
+    }
+    list_node_handle(const list_node_handle&) = delete;
+    list_node_handle& operator=(const list_node_handle&) = delete;
+    ~list_node_handle() { reset(); }
+
+    bool empty() const noexcept { return ptr == 0; }
+    explicit operator bool() const noexcept { return ptr != 0; }
+    value_type& value() const { return ptr->data; }
+    void swap(list_node_handle& rhs) { std::swap(ptr, rhs.ptr); }
+
+    // 交出节点的所有权，由调用者负责重新链接
+    link_type release() {
+        link_type tmp = ptr;
+        ptr = 0;
+        return tmp;
+    }
+
+   private:
+    void reset() {
+        if (ptr) {
+            destroy(&ptr->data);
+            Alloc::deallocate(ptr);
+            ptr = 0;
+        }
+    }
+
+    link_type ptr;
+};
+
+// 索引模式使用的顺序统计树：按链表顺序排列的 treap，每个树节点对应一个链表节点
+// size 为子树的节点数，priority 满足大根堆性质，树高期望为 O(log n)
+template <typename T>
+struct list_index_node {
+    list_node<T>* link;
+    list_index_node<T>* parent;
+    list_index_node<T>* left;
+    list_index_node<T>* right;
+    size_t size;
+    size_t priority;
+};
+
+template <typename T>
+struct list_index {
+    using node_ptr = list_index_node<T>*;
+
+    node_ptr root;
+    unordered_map<list_node<T>*, node_ptr> where;  // 由链表节点找到对应的树节点
+    size_t seed;  // 生成 priority 的 xorshift 状态
+    bool valid;   // 为 false 时树的形状与链表顺序不符，下次按位置访问时重建
+
+    list_index() : root(0), seed(0x9e3779b97f4a7c15ull), valid(false) {}
+    size_t next_priority() {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    }
+};
+
+/* 顺序统计树的基本操作，返回的根节点 parent 均为空 */
+
+template <typename T>
+inline size_t list_index_size(list_index_node<T>* x) {
+    return x ? x->size : 0;
+}
+
+template <typename T>
+inline void list_index_update(list_index_node<T>* x) {
+    x->size = list_index_size(x->left) + list_index_size(x->right) + 1;
+}
+
+// 把 b 整体接在 a 之后，a、b 均为根
+template <typename T>
+list_index_node<T>* list_index_merge(list_index_node<T>* a,
+                                     list_index_node<T>* b) {
+    if (!a)
+        return b;
+    if (!b)
+        return a;
+    if (a->priority > b->priority) {
+        a->right = list_index_merge(a->right, b);
+        a->right->parent = a;
+        list_index_update(a);
+        return a;
+    }
+    b->left = list_index_merge(a, b->left);
+    b->left->parent = b;
+    list_index_update(b);
+    return b;
+}
+
+// 前 k 个节点分到 l，其余分到 r
+template <typename T>
+void list_index_split(list_index_node<T>* t,
+                      size_t k,
+                      list_index_node<T>*& l,
+                      list_index_node<T>*& r) {
+    if (!t) {
+        l = r = 0;
+        return;
+    }
+    if (list_index_size(t->left) < k) {
+        list_index_split(t->right, k - list_index_size(t->left) - 1, t->right,
+                         r);
+        if (t->right)
+            t->right->parent = t;
+        l = t;
+    } else {
+        list_index_split(t->left, k, l, t->left);
+        if (t->left)
+            t->left->parent = t;
+        r = t;
+    }
+    t->parent = 0;
+    list_index_update(t);
+}
+
+// 第 k 个节点（从 0 开始）
+template <typename T>
+list_index_node<T>* list_index_select(list_index_node<T>* x, size_t k) {
+    for (;;) {
+        size_t left = list_index_size(x->left);
+        if (k == left)
+            return x;
+        if (k < left) {
+            x = x->left;
+        } else {
+            k -= left + 1;
+            x = x->right;
+        }
+    }
+}
+
+// x 之前的节点数，沿 parent 走到根
+template <typename T>
+size_t list_index_rank(list_index_node<T>* x) {
+    size_t result = list_index_size(x->left);
+    for (; x->parent; x = x->parent)
+        if (x == x->parent->right)
+            result += list_index_size(x->parent->left) + 1;
+    return result;
+}
+
+// 按顺序逐个追加节点建树：新节点沿最右链向上找到第一个 priority 更大的祖先，
+// 被越过的部分成为它的左子树；每个节点至多被越过一次，整体 O(n)，子树大小事后统一计算
+template <typename T>
+void list_index_append(list_index_node<T>*& root,
+                       list_index_node<T>*& last,
+                       list_index_node<T>* z) {
+    list_index_node<T>* y = last;
+    list_index_node<T>* c = 0;
+    while (y && y->priority < z->priority) {
+        c = y;
+        y = y->parent;
+    }
+    z->left = c;
+    z->right = 0;
+    if (c)
+        c->parent = z;
+    z->parent = y;
+    if (y)
+        y->right = z;
+    else
+        root = z;
+    last = z;
+}
+
+template <typename T>
+size_t list_index_fix_size(list_index_node<T>* x) {
+    if (!x)
+        return 0;
+    x->size = list_index_fix_size(x->left) + list_index_fix_size(x->right) + 1;
+    return x->size;
+}
+
 template <typename T, typename Alloc = mystl::alloc<list_node<T>>>
 class list {
    public:
@@ -88,9 +328,12 @@ class list {
     using const_iterator = list_iterator<T, const T&, const T*>;
     using reverse_iter = reverse_iterator<iterator, T>;
     using const_reverse_iter = reverse_iterator<const_iterator, T, const T&, const T*>;
+    using node_type = list_node_handle<T, Alloc>;
 
    protected:
     link_type node;
+    size_type node_count;  // 缓存元素个数，使 size() 为 O(1)
+    list_index<T>* index;  // 为空表示未开启索引模式
     /* 内部辅助函数 */
     link_type get_node() { return Alloc::allocate(); }
     void put_node(link_type ptr) { Alloc::deallocate(ptr); }
@@ -101,6 +344,26 @@ class list {
     template <typename InputIterator>
     void range_init(InputIterator first, InputIterator last);
     void transfer(iterator pos, iterator first, iterator last);
+    void erase_node(link_type x);
+
+    /* 索引维护，未开启索引模式时均直接返回 */
+    using index_node_ptr = list_index_node<T>*;
+    using index_node_alloc =
+        typename Alloc::template rebind<list_index_node<T>>::other;
+    void invalidate_index() {
+        if (index)
+            index->valid = false;
+    }
+    void build_index() const;
+    index_node_ptr new_index_node(link_type x);
+    void free_index_node(link_type x);
+    void free_index_nodes();
+    size_type index_rank(link_type x) const;
+    void index_insert(link_type pos, link_type x);
+    void index_erase(link_type x);
+    void index_adopt(link_type pos, link_type first, link_type last);
+    void index_release(link_type first, link_type last, size_type n);
+    void index_move(link_type pos, link_type first, link_type last);
 
    public:
     /* 各种构造拷贝析构函数 */
@@ -117,6 +380,7 @@ class list {
     list(std::initializer_list<T> rhs) { range_init(rhs.begin(), rhs.end()); }
     ~list() {
         clear();
+        disable_index();
         put_node(node);
     }
     list<T, Alloc>& operator=(const list<T, Alloc>& rhs);
@@ -140,7 +404,7 @@ class list {
     }
     /* 容量相关操作 */
     bool empty() const noexcept { return node->next == node; }
-    size_type size() const noexcept { return distance(begin(), end()); }
+    size_type size() const noexcept { return node_count; }
     size_type max_size() const noexcept { return size_type(-1); }
 
     /* 取值相关操作 */
@@ -149,9 +413,29 @@ class list {
     reference back() { return node->prev->data; }
     const_reference back() const { return node->prev->data; }
     reference operator[](const size_type& n);
+    const_reference operator[](const size_type& n) const;
+
+    /* 索引模式
+     * 开启后在链表之外维护一棵按链表顺序排列的顺序统计树，并用哈希表由链表节点找到树节点，
+     * operator[]、position 与 advance 为 O(log n)
+     * 插入、删除、extract 以及同一链表内的 splice 同步修改树，期望 O(log n)；
+     * 从另一条链表 splice 进 k 个元素时要登记或注销它们的树节点，为 O(k + log n)，
+     * 两条链表都未开启索引时 splice 仍为 O(1)
+     * sort、reverse、merge 只打乱树的形状，下次按位置访问时 O(n) 重建
+     * 迭代器不知道所属的链表，list_iterator::operator+ 与 mystl::advance 仍逐个节点前进，
+     * 需要按位置跳转时改用成员函数 advance */
+    void enable_index();
+    void disable_index();
+    bool index_enabled() const noexcept { return index != 0; }
+    size_type position(const_iterator pos) const;
+    iterator advance(iterator pos, difference_type n);
 
     /* 修改链表操作 */
-    void swap(list<T, Alloc>& rhs) { std::swap(node, rhs.node); }
+    void swap(list<T, Alloc>& rhs) {
+        std::swap(node, rhs.node);
+        std::swap(node_count, rhs.node_count);
+        std::swap(index, rhs.index);
+    }
     iterator insert(iterator pos, const T& value);
     iterator insert(iterator pos);
     template <typename InputIterator>
@@ -159,10 +443,12 @@ class list {
     void insert(iterator pos, size_type n, const T& value);
     void insert(iterator pos, int n, const T& value);
     void insert(iterator pos, long n, const T& value);
+    iterator insert(iterator pos, node_type&& nh);
     void push_front(const T& value) { insert(begin(), value); }
     void push_back(const T& value) { insert(end(), value); }
     iterator erase(iterator pos);
     iterator erase(iterator first, iterator last);
+    node_type extract(iterator pos);
     void resize(size_type new_size, const T& value);
     void resize(size_type new_size) { resize(new_size, T()); }
     void clear() { erase(begin(), end()); }
@@ -172,10 +458,18 @@ class list {
     void splice(iterator pos, list&, iterator i);
     void splice(iterator pos, list&, iterator first, iterator last);
     void remove(const T& value);
-    void unique();
-    void merge(list& x);
+    template <typename Predicate>
+    void remove_if(Predicate pred);
+    void unique() { unique(std::equal_to<T>()); }
+    template <typename BinaryPredicate>
+    void unique(BinaryPredicate pred);
+    void merge(list& x) { merge(x, std::less<T>()); }
+    template <typename Compare>
+    void merge(list& x, Compare comp);
     void reverse();
-    void sort();
+    void sort() { sort(std::less<T>()); }
+    template <typename Compare>
+    void sort(Compare comp);
 
     /* 比较操作符重载 */
 
@@ -207,6 +501,8 @@ void list<T, Alloc>::empty_init() {
     node = get_node();
     node->next = node;
     node->prev = node;
+    node_count = 0;
+    index = 0;
 }
 
 template <typename T, typename Alloc>
@@ -232,6 +528,7 @@ void list<T, Alloc>::range_init(InputIterator first, InputIterator last) {
     }
 }
 
+// 将 [first, last) 移动到 pos 之前，只修改指针，元素个数与索引由调用者维护
 template <typename T, typename Alloc>
 void list<T, Alloc>::transfer(iterator pos, iterator first, iterator last) {
     if (pos != last) {
@@ -245,6 +542,177 @@ void list<T, Alloc>::transfer(iterator pos, iterator first, iterator last) {
     }
 }
 
+// 摘下并释放节点，不涉及索引
+template <typename T, typename Alloc>
+void list<T, Alloc>::erase_node(link_type x) {
+    x->prev->next = x->next;
+    x->next->prev = x->prev;
+    destroy_node(x);
+    --node_count;
+}
+
+// 树节点都还登记在 where 中，按链表顺序取出重新建树，O(n)
+template <typename T, typename Alloc>
+void list<T, Alloc>::build_index() const {
+    if (index->valid)
+        return;
+    index_node_ptr root = 0;
+    index_node_ptr last = 0;
+    for (link_type cur = node->next; cur != node; cur = cur->next)
+        list_index_append(root, last, index->where.find(cur)->second);
+    list_index_fix_size(root);
+    index->root = root;
+    index->valid = true;
+}
+
+// 分配树节点并登记到 where，尚未链入树中
+template <typename T, typename Alloc>
+typename list<T, Alloc>::index_node_ptr list<T, Alloc>::new_index_node(
+    link_type x) {
+    index_node_ptr z = index_node_alloc::allocate();
+    z->link = x;
+    z->parent = z->left = z->right = 0;
+    z->size = 1;
+    z->priority = index->next_priority();
+    try {
+        index->where[x] = z;
+    } catch (...) {
+        index_node_alloc::deallocate(z);
+        throw;
+    }
+    return z;
+}
+
+// 注销并释放 x 的树节点，调用者负责先把它从树中摘下或让树失效
+template <typename T, typename Alloc>
+void list<T, Alloc>::free_index_node(link_type x) {
+    auto it = index->where.find(x);
+    index_node_alloc::deallocate(it->second);
+    index->where.erase(it);
+}
+
+template <typename T, typename Alloc>
+void list<T, Alloc>::free_index_nodes() {
+    for (auto& entry : index->where)
+        index_node_alloc::deallocate(entry.second);
+    index->where.clear();
+    index->root = 0;
+    index->valid = true;
+}
+
+// x 的位置，x 为头节点时返回 size()，要求树有效
+template <typename T, typename Alloc>
+typename list<T, Alloc>::size_type list<T, Alloc>::index_rank(
+    link_type x) const {
+    if (x == node)
+        return list_index_size(index->root);
+    return list_index_rank(index->where.find(x)->second);
+}
+
+// 在 x 链入 pos 之前调用，分配失败时链表与索引都未改变
+template <typename T, typename Alloc>
+void list<T, Alloc>::index_insert(link_type pos, link_type x) {
+    if (!index)
+        return;
+    index_node_ptr z = new_index_node(x);
+    if (!index->valid)
+        return;
+    index_node_ptr l, r;
+    list_index_split(index->root, index_rank(pos), l, r);
+    index->root = list_index_merge(list_index_merge(l, z), r);
+}
+
+// 用左右子树合并的结果顶替 x 的树节点，再沿 parent 修正子树大小
+template <typename T, typename Alloc>
+void list<T, Alloc>::index_erase(link_type x) {
+    if (!index)
+        return;
+    if (index->valid) {
+        index_node_ptr z = index->where.find(x)->second;
+        index_node_ptr c = list_index_merge(z->left, z->right);
+        index_node_ptr p = z->parent;
+        if (c)
+            c->parent = p;
+        if (!p) {
+            index->root = c;
+        } else {
+            if (p->left == z)
+                p->left = c;
+            else
+                p->right = c;
+            for (; p; p = p->parent)
+                --p->size;
+        }
+    }
+    free_index_node(x);
+}
+
+// 为另一条链表中的 [first, last) 建立树节点，整体接在 pos 之前，须在 transfer 之前调用
+// 中途分配失败时撤销已登记的节点，链表与索引都未改变
+template <typename T, typename Alloc>
+void list<T, Alloc>::index_adopt(link_type pos,
+                                 link_type first,
+                                 link_type last) {
+    if (!index)
+        return;
+    index_node_ptr m = 0;
+    index_node_ptr tail = 0;
+    link_type cur = first;
+    try {
+        for (; cur != last; cur = cur->next) {
+            index_node_ptr z = new_index_node(cur);
+            if (index->valid)
+                list_index_append(m, tail, z);
+        }
+    } catch (...) {
+        for (link_type x = first; x != cur; x = x->next)
+            free_index_node(x);
+        throw;
+    }
+    if (!index->valid)
+        return;
+    list_index_fix_size(m);
+    index_node_ptr l, r;
+    list_index_split(index->root, index_rank(pos), l, r);
+    index->root = list_index_merge(list_index_merge(l, m), r);
+}
+
+// 注销 [first, last) 共 n 个节点的树节点，它们即将移到另一条链表，须在 transfer 之前调用
+template <typename T, typename Alloc>
+void list<T, Alloc>::index_release(link_type first,
+                                   link_type last,
+                                   size_type n) {
+    if (!index)
+        return;
+    if (index->valid) {
+        index_node_ptr l, m, r;
+        list_index_split(index->root, index_rank(first), l, r);
+        list_index_split(r, n, m, r);
+        index->root = list_index_merge(l, r);
+    }
+    for (link_type cur = first; cur != last; cur = cur->next)
+        free_index_node(cur);
+}
+
+// 同一链表内把 [first, last) 移到 pos 之前，只需切下一段再接回去，须在 transfer 之前调用
+template <typename T, typename Alloc>
+void list<T, Alloc>::index_move(link_type pos,
+                                link_type first,
+                                link_type last) {
+    if (!index || !index->valid)
+        return;
+    size_type a = index_rank(first);
+    size_type b = index_rank(last);
+    size_type p = index_rank(pos);
+    if (p > a)
+        p -= b - a;
+    index_node_ptr l, m, r;
+    list_index_split(index->root, a, l, r);
+    list_index_split(r, b - a, m, r);
+    list_index_split(list_index_merge(l, r), p, l, r);
+    index->root = list_index_merge(list_index_merge(l, m), r);
+}
+
 /* list 类公开成员函数的实现 */
 
 template <typename T, typename Alloc>
@@ -254,13 +722,14 @@ list<T, Alloc>& list<T, Alloc>::operator=(const list<T, Alloc>& rhs) {
         iterator last1 = end();
         const_iterator first2 = rhs.cbegin();
         const_iterator last2 = rhs.cend();
-        for (; first1 != last1 && first2 != last2; ++first1, ++first1)
+        for (; first1 != last1 && first2 != last2; ++first1, ++first2)
             *first1 = *first2;
         if (first1 == last1)
             insert(last1, first2, last2);
         else
             erase(first1, last1);
     }
+    return *this;
 }
 
 template <typename T, typename Alloc>
@@ -269,27 +738,107 @@ list<T, Alloc>& list<T, Alloc>::operator=(std::initializer_list<T> rhs) {
     iterator last1 = end();
     auto first2 = rhs.begin();
     auto last2 = rhs.end();
-    for (; first1 != last1 && first2 != last2; ++first1, first2)
+    for (; first1 != last1 && first2 != last2; ++first1, ++first2)
         *first1 = *first2;
     if (first1 == last1)
         insert(last1, first2, last2);
     else
         erase(first1, last1);
+    return *this;
 }
 
+// 未开启索引模式时从较近的一端走过去
 template <typename T, typename Alloc>
 typename list<T, Alloc>::reference list<T, Alloc>::operator[](const size_type& n) {
-    return *(begin() + n);
+    if (index) {
+        build_index();
+        return list_index_select(index->root, n)->link->data;
+    }
+    if (n < node_count / 2)
+        return *(begin() + difference_type(n));
+    return *(end() - difference_type(node_count - n));
+}
+
+template <typename T, typename Alloc>
+typename list<T, Alloc>::const_reference list<T, Alloc>::operator[](
+    const size_type& n) const {
+    return const_cast<list*>(this)->operator[](n);
+}
+
+// 为每个节点登记树节点，树本身留到第一次按位置访问时再建
+template <typename T, typename Alloc>
+void list<T, Alloc>::enable_index() {
+    using index_alloc = typename Alloc::template rebind<list_index<T>>::other;
+    if (index)
+        return;
+    list_index<T>* p = index_alloc::allocate();
+    try {
+        mystl::construct(p);
+    } catch (...) {
+        index_alloc::deallocate(p);
+        throw;
+    }
+    index = p;
+    try {
+        index->where.reserve(node_count);
+        for (link_type cur = node->next; cur != node; cur = cur->next)
+            new_index_node(cur);
+    } catch (...) {
+        disable_index();
+        throw;
+    }
+}
+
+template <typename T, typename Alloc>
+void list<T, Alloc>::disable_index() {
+    using index_alloc = typename Alloc::template rebind<list_index<T>>::other;
+    if (!index)
+        return;
+    free_index_nodes();
+    mystl::destroy(index);
+    index_alloc::deallocate(index);
+    index = 0;
+}
+
+// 返回 pos 距 begin() 的距离，end() 的位置为 size()
+template <typename T, typename Alloc>
+typename list<T, Alloc>::size_type list<T, Alloc>::position(
+    const_iterator pos) const {
+    if (pos.node == node)
+        return node_count;
+    if (!index)
+        return size_type(mystl::distance(begin(), pos));
+    build_index();
+    return index_rank(pos.node);
+}
+
+template <typename T, typename Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::advance(iterator pos,
+                                                          difference_type n) {
+    if (!index)
+        return pos + n;
+    size_type target = position(pos) + n;
+    if (target == node_count)
+        return end();
+    return list_index_select(index->root, target)->link;
 }
 
 template <typename T, typename Alloc>
 typename list<T, Alloc>::iterator list<T, Alloc>::insert(iterator pos,
                                                          const T& value) {
     link_type tmp = create_node(value);
+    try {
+        index_insert(pos.node, tmp);
+    } catch (...) {
+        destroy_node(tmp);
+        throw;
+    }
     pos.node->prev->next = tmp;
     tmp->prev = pos.node->prev;
     pos.node->prev = tmp;
     tmp->next = pos.node;
+    ++node_count;
+    return tmp;
 }
 
 template <typename T, typename Alloc>
@@ -319,17 +868,54 @@ void list<T, Alloc>::insert(iterator pos, long n, const T& value) {
 
 template <typename T, typename Alloc>
 typename list<T, Alloc>::iterator list<T, Alloc>::erase(iterator pos) {
-    iterator tmp = pos;
-    ++tmp;
-    pos.node->prev->next = tmp.node;
-    tmp.node->prev = pos.node->prev;
-    destroy_node(pos.node);
+    link_type next = pos.node->next;
+    index_erase(pos.node);
+    erase_node(pos.node);
+    return next;
+}
+
+// 摘下节点但不释放，交由节点句柄持有
+template <typename T, typename Alloc>
+typename list<T, Alloc>::node_type list<T, Alloc>::extract(iterator pos) {
+    link_type x = pos.node;
+    index_erase(x);
+    x->prev->next = x->next;
+    x->next->prev = x->prev;
+    --node_count;
+    return node_type(x);
+}
+
+// 句柄为空时不做任何事并返回 pos
+template <typename T, typename Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::insert(iterator pos,
+                                                         node_type&& nh) {
+    if (nh.empty())
+        return pos;
+    link_type tmp = nh.release();
+    try {
+        index_insert(pos.node, tmp);
+    } catch (...) {
+        nh = node_type(tmp);
+        throw;
+    }
+    pos.node->prev->next = tmp;
+    tmp->prev = pos.node->prev;
+    pos.node->prev = tmp;
+    tmp->next = pos.node;
+    ++node_count;
     return tmp;
 }
 
+// 删除整条链表时直接清空索引，不必逐个从树中摘下
 template <typename T, typename Alloc>
 typename list<T, Alloc>::iterator list<T, Alloc>::erase(iterator first,
                                                         iterator last) {
+    if (index && first == begin() && last == end()) {
+        free_index_nodes();
+        while (first != last)
+            erase_node((first++).node);
+        return last;
+    }
     while(first != last)
         erase(first++);
     return last;
@@ -352,25 +938,47 @@ template <typename T, typename Alloc>
 void list<T, Alloc>::splice(iterator pos, list<T, Alloc>& x) {
     if (x.empty())
         return;
+    index_adopt(pos.node, x.node->next, x.node);
+    x.index_release(x.node->next, x.node, x.node_count);
     transfer(pos, x.begin(), x.end());
+    node_count += x.node_count;
+    x.node_count = 0;
 }
 
 template <typename T, typename Alloc>
-void list<T, Alloc>::splice(iterator pos, list&, iterator i) {
+void list<T, Alloc>::splice(iterator pos, list& x, iterator i) {
     iterator j = i;
     ++j;
     if (pos == i || pos == j)
         return;
+    if (&x == this) {
+        index_move(pos.node, i.node, j.node);
+    } else {
+        index_adopt(pos.node, i.node, j.node);
+        x.index_release(i.node, j.node, 1);
+    }
     transfer(pos, i, j);
+    ++node_count;
+    --x.node_count;
 }
 
 template <typename T, typename Alloc>
 void list<T, Alloc>::splice(iterator pos,
-                            list&,
+                            list& x,
                             iterator first,
                             iterator last) {
     if (first == last)
         return;
+    // 同一链表内部移动时元素个数不变，否则只能数一遍区间长度
+    if (&x != this) {
+        size_type n = mystl::distance(first, last);
+        index_adopt(pos.node, first.node, last.node);
+        x.index_release(first.node, last.node, n);
+        node_count += n;
+        x.node_count -= n;
+    } else {
+        index_move(pos.node, first.node, last.node);
+    }
     transfer(pos, first, last);
 }
 
@@ -378,43 +986,75 @@ template <typename T, typename Alloc>
 void list<T, Alloc>::remove(const T& value) {
     iterator first = begin();
     iterator last = end();
-    for (; first != last; ++first)
+    while (first != last) {
         if (*first == value)
-            erase(first);
+            first = erase(first);
+        else
+            ++first;
+    }
 }
 
 template <typename T, typename Alloc>
-void list<T, Alloc>::unique() {
+template <typename Predicate>
+void list<T, Alloc>::remove_if(Predicate pred) {
+    iterator first = begin();
+    iterator last = end();
+    while (first != last) {
+        if (pred(*first))
+            first = erase(first);
+        else
+            ++first;
+    }
+}
+
+// 相邻且满足 pred 的元素只保留第一个
+template <typename T, typename Alloc>
+template <typename BinaryPredicate>
+void list<T, Alloc>::unique(BinaryPredicate pred) {
     if (empty())
         return;
     iterator first = begin();
     iterator last = end();
     iterator next = first;
     while (++next != last) {
-        if (*first == *next)
-            first = erase(first);
+        if (pred(*first, *next))
+            erase(next);
         else
             first = next;
+        next = first;
     }
 }
 
+// 两个链表均应已按 comp 排好序，只移动节点不分配内存，相等时 *this 中的元素在前
 template <typename T, typename Alloc>
-void list<T, Alloc>::merge(list<T, Alloc>& x) {
-    if (x.empty())
+template <typename Compare>
+void list<T, Alloc>::merge(list<T, Alloc>& x, Compare comp) {
+    if (x.empty() || &x == this)
         return;
+    // 先把 x 的节点整体登记到本链表的索引中，之后只剩重排，树留待下次访问时重建
+    index_adopt(node, x.node->next, x.node);
+    x.index_release(x.node->next, x.node, x.node_count);
+    invalidate_index();
     iterator first1 = begin();
     iterator last1 = end();
     iterator first2 = x.begin();
     iterator last2 = x.end();
     while (first1 != last1 && first2 != last2) {
-        if (*first2 < *first1) {
-            splice(first1, x, first2);
-            first2 = x.begin();
+        if (comp(*first2, *first1)) {
+            iterator next = first2;
+            transfer(first1, first2, ++next);
+            first2 = next;
+            ++node_count;
+            --x.node_count;
         } else
             ++first1;
     }
-    if (first1 == last1)
-        splice(last1, x, first2, last2);
+    // 此时 x 中剩下的元素都不小于 *this 中的元素，整体接到末尾即可
+    if (first2 != last2) {
+        transfer(last1, first2, last2);
+        node_count += x.node_count;
+        x.node_count = 0;
+    }
 }
 
 template <typename T, typename Alloc>
@@ -429,29 +1069,38 @@ void list<T, Alloc>::reverse() {
         ++first;
         transfer(begin(), old, first);
     }
+    invalidate_index();
 }
 
+// 把节点指针收集到连续数组中排序再重新链接，避免排序过程中沿 next 指针跳跃访存
+// 排序中若 comp 抛出异常，链表保持原样
 template <typename T, typename Alloc>
-void list<T, Alloc>::sort() {
-    if (node->next == node || node->next->next == node)
+template <typename Compare>
+void list<T, Alloc>::sort(Compare comp) {
+    if (node_count < 2)
         return;
-    list<T, Alloc> carry;
-    list<T, Alloc> counter[64];
-    int fill = 0;
-    while (!empty()) {
-        carry.splice(carry.begin(), *this, begin());
-        int i = 0;
-        while (i < fill && !counter[i].empty()) {
-            counter[i].merge(carry);
-            carry.swap(counter[i++]);
-        }
-        carry.swap(counter[i]);
-        if (i == fill)
-            ++fill;
+    using ptr_alloc = typename Alloc::template rebind<link_type>::other;
+    const size_type n = node_count;
+    link_type* links = ptr_alloc::allocate(2 * n);
+    try {
+        link_type cur = node->next;
+        for (size_type i = 0; i != n; ++i, cur = cur->next)
+            links[i] = cur;
+        sort_links(links, links + n, n, comp);
+    } catch (...) {
+        ptr_alloc::deallocate(links, 2 * n);
+        throw;
+    }
+    link_type prev = node;
+    for (size_type i = 0; i != n; ++i) {
+        prev->next = links[i];
+        links[i]->prev = prev;
+        prev = links[i];
     }
-    for (int i = 1; i < fill; ++i)
-        counter[i].merge(counter[i - 1]);
-    swap(counter[fill - 1]);
+    prev->next = node;
+    node->prev = prev;
+    invalidate_index();
+    ptr_alloc::deallocate(links, 2 * n);
 }
 
 template <typename T, class Alloc>
@@ -0,0 +1,277 @@
+#if !defined(MYSTL_MAP_H_)
+#define MYSTL_MAP_H_
+
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include "tree.h"
+
+namespace mystl {
+// 以 rb_tree 为底层容器，元素为 pair<const Key, T>，由 _Select1st 取出键
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class map {
+public:
+    using key_type      = Key;
+    using mapped_type   = T;
+    using value_type    = std::pair<const Key, T>;
+    using key_compare   = Compare;
+
+    // 只比较键的函数对象
+    class value_compare {
+        friend class map<Key, T, Compare>;
+
+    protected:
+        Compare comp;
+        value_compare(Compare c) : comp(c) {}
+
+    public:
+        bool operator()(const value_type& x, const value_type& y) const {
+            return comp(x.first, y.first);
+        }
+    };
+
+private:
+    using rep_type =
+        rb_tree<Key, value_type, std::_Select1st<value_type>, Compare>;
+    rep_type tree;
+
+public:
+    using pointer           = typename rep_type::pointer;
+    using const_pointer     = typename rep_type::const_pointer;
+    using reference         = typename rep_type::reference;
+    using const_reference   = typename rep_type::const_reference;
+    using iterator          = typename rep_type::iterator;
+    using const_iterator    = typename rep_type::const_iterator;
+    using difference_type   = typename rep_type::difference_type;
+    using size_type         = typename rep_type::size_type;
+    using node_type         = typename rep_type::node_type;
+
+    // 构造函数
+    map() : tree(Compare()) {}
+    explicit map(const Compare& comp) : tree(comp) {}
+    template <typename InputIterator>
+    map(InputIterator first, InputIterator last) : tree(Compare()) {
+        tree.insert_unique(first, last);
+    }
+    template <typename InputIterator>
+    map(InputIterator first, InputIterator last, const Compare& comp)
+        : tree(comp) {
+        tree.insert_unique(first, last);
+    }
+    map(const map& x) : tree(x.tree) {}
+    map& operator=(const map& x) {
+        tree = x.tree;
+        return *this;
+    }
+
+    key_compare     key_comp()   const { return tree.key_comp(); }
+    value_compare   value_comp() const { return value_compare(tree.key_comp()); }
+    iterator        begin()            { return tree.begin(); }
+    const_iterator  begin()      const { return tree.begin(); }
+    iterator        end()              { return tree.end(); }
+    const_iterator  end()        const { return tree.end(); }
+    bool            empty()      const { return tree.empty(); }
+    size_type       size()       const { return tree.size(); }
+    size_type       max_size()   const { return tree.max_size(); }
+    void            swap(map& x) { tree.swap(x.tree); }
+
+    // 键不存在时在 lower_bound 处带提示插入 T()，不再重复查找
+    T& operator[](const key_type& k) {
+        return try_emplace(k).first->second;
+    }
+    T& at(const key_type& k) {
+        iterator i = find(k);
+        if (i == end())
+            throw std::out_of_range("map::at");
+        return i->second;
+    }
+    const T& at(const key_type& k) const {
+        const_iterator i = find(k);
+        if (i == end())
+            throw std::out_of_range("map::at");
+        return i->second;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& x) {
+        return tree.insert_unique(x);
+    }
+    iterator insert(iterator position, const value_type& x) {
+        return tree.insert_unique(position, x);
+    }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        tree.insert_unique(first, last);
+    }
+
+    // 键已存在时不构造 T，args 也不会被移走
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args) {
+        iterator i = lower_bound(k);
+        if (i != end() && !key_comp()(k, i->first))
+            return std::pair<iterator, bool>(i, false);
+        i = tree.insert_unique(
+            i, value_type(k, T(std::forward<Args>(args)...)));
+        return std::pair<iterator, bool>(i, true);
+    }
+
+    // 键已存在时赋值，否则插入
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj) {
+        iterator i = lower_bound(k);
+        if (i != end() && !key_comp()(k, i->first)) {
+            i->second = std::forward<M>(obj);
+            return std::pair<iterator, bool>(i, false);
+        }
+        i = tree.insert_unique(i, value_type(k, std::forward<M>(obj)));
+        return std::pair<iterator, bool>(i, true);
+    }
+
+    node_type extract(iterator position) { return tree.extract(position); }
+    node_type extract(const key_type& x) { return tree.extract(x); }
+    std::pair<iterator, bool> insert(node_type&& nh) {
+        return tree.insert_unique(std::move(nh));
+    }
+
+    void erase(iterator position) { tree.erase(position); }
+    size_type erase(const key_type& x) { return tree.erase(x); }
+    void erase(iterator first, iterator last) { tree.erase(first, last); }
+    void clear() { tree.clear(); }
+
+    iterator find(const key_type& x) { return tree.find(x); }
+    const_iterator find(const key_type& x) const { return tree.find(x); }
+    size_type count(const key_type& x) const { return tree.count(x); }
+    iterator lower_bound(const key_type& x) { return tree.lower_bound(x); }
+    const_iterator lower_bound(const key_type& x) const {
+        return tree.lower_bound(x);
+    }
+    iterator upper_bound(const key_type& x) { return tree.upper_bound(x); }
+    const_iterator upper_bound(const key_type& x) const {
+        return tree.upper_bound(x);
+    }
+    std::pair<iterator, iterator> equal_range(const key_type& x) {
+        return tree.equal_range(x);
+    }
+    std::pair<const_iterator, const_iterator> equal_range(
+        const key_type& x) const {
+        return tree.equal_range(x);
+    }
+}; // typename map
+
+template <typename Key, typename T, typename Compare>
+inline void swap(map<Key, T, Compare>& lhs, map<Key, T, Compare>& rhs) {
+    lhs.swap(rhs);
+}
+
+// 允许键重复的 map，插入均走 insert_equal，没有 operator[]
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class multimap {
+public:
+    using key_type      = Key;
+    using mapped_type   = T;
+    using value_type    = std::pair<const Key, T>;
+    using key_compare   = Compare;
+
+    class value_compare {
+        friend class multimap<Key, T, Compare>;
+
+    protected:
+        Compare comp;
+        value_compare(Compare c) : comp(c) {}
+
+    public:
+        bool operator()(const value_type& x, const value_type& y) const {
+            return comp(x.first, y.first);
+        }
+    };
+
+private:
+    using rep_type =
+        rb_tree<Key, value_type, std::_Select1st<value_type>, Compare>;
+    rep_type tree;
+
+public:
+    using pointer           = typename rep_type::pointer;
+    using const_pointer     = typename rep_type::const_pointer;
+    using reference         = typename rep_type::reference;
+    using const_reference   = typename rep_type::const_reference;
+    using iterator          = typename rep_type::iterator;
+    using const_iterator    = typename rep_type::const_iterator;
+    using difference_type   = typename rep_type::difference_type;
+    using size_type         = typename rep_type::size_type;
+    using node_type         = typename rep_type::node_type;
+
+    // 构造函数
+    multimap() : tree(Compare()) {}
+    explicit multimap(const Compare& comp) : tree(comp) {}
+    template <typename InputIterator>
+    multimap(InputIterator first, InputIterator last) : tree(Compare()) {
+        tree.insert_equal(first, last);
+    }
+    template <typename InputIterator>
+    multimap(InputIterator first, InputIterator last, const Compare& comp)
+        : tree(comp) {
+        tree.insert_equal(first, last);
+    }
+    multimap(const multimap& x) : tree(x.tree) {}
+    multimap& operator=(const multimap& x) {
+        tree = x.tree;
+        return *this;
+    }
+
+    key_compare     key_comp()   const { return tree.key_comp(); }
+    value_compare   value_comp() const { return value_compare(tree.key_comp()); }
+    iterator        begin()            { return tree.begin(); }
+    const_iterator  begin()      const { return tree.begin(); }
+    iterator        end()              { return tree.end(); }
+    const_iterator  end()        const { return tree.end(); }
+    bool            empty()      const { return tree.empty(); }
+    size_type       size()       const { return tree.size(); }
+    size_type       max_size()   const { return tree.max_size(); }
+    void            swap(multimap& x) { tree.swap(x.tree); }
+
+    iterator insert(const value_type& x) { return tree.insert_equal(x); }
+    iterator insert(iterator position, const value_type& x) {
+        return tree.insert_equal(position, x);
+    }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        tree.insert_equal(first, last);
+    }
+
+    node_type extract(iterator position) { return tree.extract(position); }
+    node_type extract(const key_type& x) { return tree.extract(x); }
+    iterator insert(node_type&& nh) { return tree.insert_equal(std::move(nh)); }
+
+    void erase(iterator position) { tree.erase(position); }
+    size_type erase(const key_type& x) { return tree.erase(x); }
+    void erase(iterator first, iterator last) { tree.erase(first, last); }
+    void clear() { tree.clear(); }
+
+    iterator find(const key_type& x) { return tree.find(x); }
+    const_iterator find(const key_type& x) const { return tree.find(x); }
+    size_type count(const key_type& x) const { return tree.count(x); }
+    iterator lower_bound(const key_type& x) { return tree.lower_bound(x); }
+    const_iterator lower_bound(const key_type& x) const {
+        return tree.lower_bound(x);
+    }
+    iterator upper_bound(const key_type& x) { return tree.upper_bound(x); }
+    const_iterator upper_bound(const key_type& x) const {
+        return tree.upper_bound(x);
+    }
+    std::pair<iterator, iterator> equal_range(const key_type& x) {
+        return tree.equal_range(x);
+    }
+    std::pair<const_iterator, const_iterator> equal_range(
+        const key_type& x) const {
+        return tree.equal_range(x);
+    }
+}; // typename multimap
+
+template <typename Key, typename T, typename Compare>
+inline void swap(multimap<Key, T, Compare>& lhs,
+                 multimap<Key, T, Compare>& rhs) {
+    lhs.swap(rhs);
+}
+}  // namespace mystl
+
+#endif  // MYSTL_MAP_H_
@@ -0,0 +1,131 @@
+#if !defined(MYSTL_MPMC_QUEUE_H_)
+#define MYSTL_MPMC_QUEUE_H_
+
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include "memory.h"
+#include "spsc_queue.h"
+
+/* 本头文件实现了一个定长的多生产者多消费者无锁队列
+ * 每个槽位带一个序号：序号等于入队下标时槽位可写，等于入队下标 + 1 时槽位可读
+ * 生产者与消费者分别用 CAS 抢占 tail 与 head，抢到下标后只操作自己的槽位 */
+namespace mystl {
+
+template <typename T>
+struct mpmc_cell {
+    std::atomic<size_t> sequence;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+    T* data() { return reinterpret_cast<T*>(&storage); }
+};
+
+template <typename T, typename Alloc = alloc<T>>
+class mpmc_queue {
+public:
+    using value_type        = T;
+    using reference         = T&;
+    using const_reference   = const T&;
+    using size_type         = size_t;
+
+protected:
+    using cell_type     = mpmc_cell<T>;
+    using cell_alloc    = typename Alloc::template rebind<cell_type>::other;
+
+    alignas(cache_line_size) cell_type* buffer;
+    size_type mask;
+    alignas(cache_line_size) std::atomic<size_type> tail;
+    alignas(cache_line_size) std::atomic<size_type> head;
+
+public:
+    explicit mpmc_queue(size_type n)
+        : buffer(0), mask(round_up_pow2(n < 2 ? 2 : n) - 1), tail(0), head(0) {
+        buffer = cell_alloc::allocate(mask + 1);
+        for (size_type i = 0; i <= mask; ++i)
+            new (&buffer[i].sequence) std::atomic<size_type>(i);
+    }
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+    ~mpmc_queue() {
+        size_type h = head.load(std::memory_order_relaxed);
+        size_type t = tail.load(std::memory_order_relaxed);
+        for (; h != t; ++h)
+            destroy(buffer[h & mask].data());
+        cell_alloc::deallocate(buffer, mask + 1);
+    }
+
+    /* 容量相关操作，size 与 empty 在并发时只是一个近似值 */
+    size_type capacity() const { return mask + 1; }
+    size_type size() const {
+        size_type h = head.load(std::memory_order_acquire);
+        size_type t = tail.load(std::memory_order_acquire);
+        return t > h ? t - h : 0;
+    }
+    bool empty() const { return size() == 0; }
+
+    /* 非阻塞接口，失败时立即返回 false */
+    bool try_push(const value_type& value);
+    bool try_pop(value_type& value);
+
+    /* 阻塞接口，队列满或空时让出时间片并重试 */
+    void push(const value_type& value) {
+        while (!try_push(value))
+            std::this_thread::yield();
+    }
+    void pop(value_type& value) {
+        while (!try_pop(value))
+            std::this_thread::yield();
+    }
+};  // end mpmc_queue
+
+template <typename T, typename Alloc>
+bool mpmc_queue<T, Alloc>::try_push(const value_type& value) {
+    cell_type* cell;
+    size_type pos = tail.load(std::memory_order_relaxed);
+    for (;;) {
+        cell = &buffer[pos & mask];
+        size_type seq = cell->sequence.load(std::memory_order_acquire);
+        ptrdiff_t diff = ptrdiff_t(seq) - ptrdiff_t(pos);
+        if (diff == 0) {
+            if (tail.compare_exchange_weak(pos, pos + 1,
+                                           std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return false;  // 槽位还未被消费，队列已满
+        } else {
+            pos = tail.load(std::memory_order_relaxed);
+        }
+    }
+    construct(cell->data(), value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T, typename Alloc>
+bool mpmc_queue<T, Alloc>::try_pop(value_type& value) {
+    cell_type* cell;
+    size_type pos = head.load(std::memory_order_relaxed);
+    for (;;) {
+        cell = &buffer[pos & mask];
+        size_type seq = cell->sequence.load(std::memory_order_acquire);
+        ptrdiff_t diff = ptrdiff_t(seq) - ptrdiff_t(pos + 1);
+        if (diff == 0) {
+            if (head.compare_exchange_weak(pos, pos + 1,
+                                           std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return false;  // 槽位还未被写入，队列为空
+        } else {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+    value = std::move(*cell->data());
+    destroy(cell->data());
+    // 槽位留给下一圈的生产者
+    cell->sequence.store(pos + mask + 1, std::memory_order_release);
+    return true;
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_MPMC_QUEUE_H_
@@ -0,0 +1,96 @@
+#if !defined(MYSTL_PERSISTENT_SET_H_)
+#define MYSTL_PERSISTENT_SET_H_
+
+#include <functional>
+#include "persistent_tree.h"
+
+namespace mystl {
+// 以可持久化红黑树为底层容器的 set，复制与 snapshot() 都是 O(1)，
+// 写者修改时只复制与快照共享的 O(log n) 个节点，快照可以交给其他线程只读访问。
+// 本对象自身不是线程安全的，同一时刻只能有一个线程修改它
+template <typename Key, typename Compare = std::less<Key>>
+class persistent_set {
+private:
+    using rep_type = persistent_rb_tree<Key, Key, std::_Identity<Key>, Compare>;
+    rep_type tree;
+
+    explicit persistent_set(const rep_type& x) : tree(x) {}
+
+public:
+    using key_type      = Key;
+    using value_type    = Key;
+    using key_compare   = Compare;
+    using value_compare = Compare;
+
+    using pointer           = typename rep_type::const_pointer;
+    using const_pointer     = typename rep_type::const_pointer;
+    using reference         = typename rep_type::const_reference;
+    using const_reference   = typename rep_type::const_reference;
+    using iterator          = typename rep_type::const_iterator;
+    using const_iterator    = typename rep_type::const_iterator;
+    using difference_type   = typename rep_type::difference_type;
+    using size_type         = typename rep_type::size_type;
+
+    // 构造函数
+    persistent_set() : tree(Compare()) {}
+    explicit persistent_set(const Compare& comp) : tree(comp) {}
+    template <typename InputIterator>
+    persistent_set(InputIterator first, InputIterator last) : tree(Compare()) {
+        tree.insert_unique(first, last);
+    }
+    template <typename InputIterator>
+    persistent_set(InputIterator first, InputIterator last,
+                   const Compare& comp)
+        : tree(comp) {
+        tree.insert_unique(first, last);
+    }
+    persistent_set(const persistent_set& x) : tree(x.tree) {}
+    persistent_set& operator=(const persistent_set& x) {
+        tree = x.tree;
+        return *this;
+    }
+
+    // 当前内容的只读快照，之后对本集合的修改对快照不可见
+    persistent_set snapshot() const { return persistent_set(tree.snapshot()); }
+
+    key_compare     key_comp()   const { return tree.key_comp(); }
+    value_compare   value_comp() const { return tree.key_comp(); }
+    iterator        begin()      const { return tree.begin(); }
+    iterator        end()        const { return tree.end(); }
+    bool            empty()      const { return tree.empty(); }
+    size_type       size()       const { return tree.size(); }
+    size_type       max_size()   const { return tree.max_size(); }
+    void            swap(persistent_set& x) { tree.swap(x.tree); }
+
+    std::pair<iterator, bool> insert(const value_type& x) {
+        return tree.insert_unique(x);
+    }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        tree.insert_unique(first, last);
+    }
+    size_type erase(const key_type& x) { return tree.erase(x); }
+    void clear() { tree.clear(); }
+
+    iterator find(const key_type& x) const { return tree.find(x); }
+    size_type count(const key_type& x) const { return tree.count(x); }
+    iterator lower_bound(const key_type& x) const {
+        return tree.lower_bound(x);
+    }
+    iterator upper_bound(const key_type& x) const {
+        return tree.upper_bound(x);
+    }
+    std::pair<iterator, iterator> equal_range(const key_type& x) const {
+        return tree.equal_range(x);
+    }
+    bool rb_verify() const { return tree.rb_verify(); }
+};  // class persistent_set
+
+template <typename Key, typename Compare>
+inline void swap(persistent_set<Key, Compare>& lhs,
+                 persistent_set<Key, Compare>& rhs) {
+    lhs.swap(rhs);
+}
+}  // namespace mystl
+
+#endif  // MYSTL_PERSISTENT_SET_H_
@@ -0,0 +1,493 @@
+#if !defined(MYSTL_PERSISTENT_TREE_H_)
+#define MYSTL_PERSISTENT_TREE_H_
+
+#include <stddef.h>
+#include <atomic>
+#include <new>
+#include <utility>
+#include "allocator.h"
+#include "construct.h"
+#include "iterator.h"
+
+/* 本头文件实现了可持久化（写时复制）的红黑树。
+ * rb_tree 依赖父指针和 header 节点，一个节点只能属于一棵树，无法共享；
+ * 这里的节点没有父指针，带引用计数，多个版本可以共享同一棵子树：
+ *   - snapshot() 只复制根指针并增加引用计数，O(1)
+ *   - 插入删除从根向下修改时，遇到被共享的节点先复制一份（路径复制），
+ *     每次更新最多复制 O(log n) 个节点；没有快照时节点只被引用一次，原地修改
+ * 平衡采用左倾红黑树（Sedgewick），插入删除都是返回新子树根的递归，
+ * 便于在下降途中逐个替换被共享的节点。
+ * 修改途中会复制元素，要求元素的复制构造函数不抛出异常 */
+
+namespace mystl {
+
+template <typename Value>
+struct persistent_tree_node {
+    using link_type = persistent_tree_node<Value>*;
+
+    // 引用计数：来自父节点与各版本根指针的引用数
+    // 快照可能在其他线程中析构，因此使用原子计数
+    std::atomic<size_t> refs;
+    link_type           left;
+    link_type           right;
+    bool                red;
+    Value               value;
+
+    static link_type minimum(link_type ptr) {
+        while (ptr->left != NULL)
+            ptr = ptr->left;
+        return ptr;
+    }
+};
+
+// 节点没有父指针，迭代器用栈保存从根到当前节点途中所有向左走过的节点，
+// 栈顶即当前节点；左倾红黑树高度不超过 2log(n)，96 层足够
+template <typename Value>
+struct persistent_tree_iterator {
+    using value_type        = Value;
+    using reference         = const Value&;
+    using pointer           = const Value*;
+    using difference_type   = ptrdiff_t;
+    using iterator_category = forward_iterator_tag;
+    using self              = persistent_tree_iterator<Value>;
+    using link_type         = persistent_tree_node<Value>*;
+
+    enum { max_height = 96 };
+    link_type   path[max_height];
+    int         depth;
+
+    persistent_tree_iterator() : depth(0) {}
+
+    link_type node() const { return depth == 0 ? NULL : path[depth - 1]; }
+    void push_left(link_type x) {
+        for (; x != NULL; x = x->left)
+            path[depth++] = x;
+    }
+
+    reference operator*() const { return path[depth - 1]->value; }
+    pointer operator->() const { return &(operator*()); }
+    self& operator++() {
+        push_left(path[--depth]->right);
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    bool operator==(const self& x) const { return node() == x.node(); }
+    bool operator!=(const self& x) const { return node() != x.node(); }
+};
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+class persistent_rb_tree {
+   public:
+    using key_type          = Key;
+    using value_type        = Value;
+    using pointer           = const value_type*;
+    using const_pointer     = const value_type*;
+    using reference         = const value_type&;
+    using const_reference   = const value_type&;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    using iterator          = persistent_tree_iterator<Value>;
+    using const_iterator    = iterator;
+
+   protected:
+    using node_type         = persistent_tree_node<Value>;
+    using link_type         = node_type*;
+    // 快照常被交给其他线程并在那里释放，alloc 的内存池不是线程安全的，
+    // 所以节点直接用 operator new 分配
+    using node_allocator    = allocator<node_type>;
+
+    link_type root;
+    size_type node_count;
+    Compare key_compare;
+
+    static link_type get_node() { return node_allocator::allocate(); }
+    static void put_node(link_type ptr) { node_allocator::deallocate(ptr); }
+    static link_type create_node(const value_type& value) {
+        link_type tmp = get_node();
+        try {
+            mystl::construct(&tmp->value, value);
+        } catch (...) {
+            put_node(tmp);
+            throw;
+        }
+        new (&tmp->refs) std::atomic<size_t>(1);
+        tmp->left = NULL;
+        tmp->right = NULL;
+        tmp->red = true;
+        return tmp;
+    }
+    static void destroy_node(link_type ptr) {
+        mystl::destroy(&ptr->value);
+        put_node(ptr);
+    }
+
+    static const Key& key(link_type cur) { return KeyOfValue()(cur->value); }
+    static bool is_red(link_type cur) { return cur != NULL && cur->red; }
+    static void acquire(link_type cur) {
+        if (cur != NULL)
+            cur->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    static void release(link_type cur);
+    static link_type mutable_node(link_type cur);
+
+    static link_type rotate_left(link_type h);
+    static link_type rotate_right(link_type h);
+    static void flip_colors(link_type h);
+    static link_type move_red_left(link_type h);
+    static link_type move_red_right(link_type h);
+    static link_type balance(link_type h);
+    static link_type erase_min(link_type h);
+    link_type insert_aux(link_type h, const value_type& value);
+    link_type erase_aux(link_type h, const key_type& k);
+    int verify_aux(link_type x, bool& ok) const;
+
+   public:
+    persistent_rb_tree(const Compare& comp = Compare())
+        : root(NULL), node_count(0), key_compare(comp) {}
+    // 复制只共享根节点，O(1)，与 snapshot() 相同
+    persistent_rb_tree(const persistent_rb_tree& x)
+        : root(x.root), node_count(x.node_count), key_compare(x.key_compare) {
+        acquire(root);
+    }
+    persistent_rb_tree& operator=(const persistent_rb_tree& x) {
+        if (this != &x) {
+            acquire(x.root);
+            release(root);
+            root = x.root;
+            node_count = x.node_count;
+            key_compare = x.key_compare;
+        }
+        return *this;
+    }
+    ~persistent_rb_tree() { release(root); }
+
+    // 返回当前版本的只读快照，此后对本树的修改不会影响快照
+    persistent_rb_tree snapshot() const { return *this; }
+
+    Compare key_comp() const { return key_compare; }
+    iterator begin() const {
+        iterator it;
+        it.push_left(root);
+        return it;
+    }
+    iterator end() const { return iterator(); }
+    bool empty() const { return node_count == 0; }
+    size_type size() const { return node_count; }
+    size_type max_size() const { return size_type(-1); }
+
+    void swap(persistent_rb_tree& rhs) {
+        std::swap(root, rhs.root);
+        std::swap(node_count, rhs.node_count);
+        std::swap(key_compare, rhs.key_compare);
+    }
+
+    // 修改会使本树已有的迭代器失效，快照的迭代器不受影响
+    std::pair<iterator, bool> insert_unique(const value_type& value);
+    template <typename InputIterator>
+    void insert_unique(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert_unique(*first);
+    }
+    size_type erase(const key_type& k);
+    void clear() {
+        release(root);
+        root = NULL;
+        node_count = 0;
+    }
+
+    iterator find(const key_type& k) const;
+    size_type count(const key_type& k) const {
+        return find(k) == end() ? 0 : 1;
+    }
+    iterator lower_bound(const key_type& k) const;
+    iterator upper_bound(const key_type& k) const;
+    std::pair<iterator, iterator> equal_range(const key_type& k) const {
+        return std::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+    }
+    bool rb_verify() const;
+};  // class persistent_rb_tree
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+inline void swap(persistent_rb_tree<Key, Value, KeyOfValue, Compare>& lhs,
+                 persistent_rb_tree<Key, Value, KeyOfValue, Compare>& rhs) {
+    lhs.swap(rhs);
+}
+
+// 释放一个引用，计数归零时递归释放子树，递归深度不超过树高
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void persistent_rb_tree<Key, Value, KeyOfValue, Compare>::release(
+    link_type cur) {
+    while (cur != NULL &&
+           cur->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        link_type right = cur->right;
+        release(cur->left);
+        destroy_node(cur);
+        cur = right;
+    }
+}
+
+// 写时复制：只被引用一次的节点直接返回，可以原地修改；
+// 被共享的节点复制一份，新节点继承对两个孩子的引用，并放弃对原节点的引用。
+// 调用者随后必须把返回值存回原来指向 cur 的位置
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::link_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::mutable_node(
+    link_type cur) {
+    if (cur == NULL || cur->refs.load(std::memory_order_acquire) == 1)
+        return cur;
+    link_type tmp = create_node(cur->value);
+    tmp->red = cur->red;
+    tmp->left = cur->left;
+    tmp->right = cur->right;
+    acquire(tmp->left);
+    acquire(tmp->right);
+    release(cur);
+    return tmp;
+}
+
+// 以下旋转与变色函数要求 h 已经是可修改的，被改动的孩子先经过 mutable_node
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::link_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::rotate_left(link_type h) {
+    link_type x = h->right = mutable_node(h->right);
+    h->right = x->left;
+    x->left = h;
+    x->red = h->red;
+    h->red = true;
+    return x;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::link_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::rotate_right(
+    link_type h) {
+    link_type x = h->left = mutable_node(h->left);
+    h->left = x->right;
+    x->right = h;
+    x->red = h->red;
+    h->red = true;
+    return x;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+void persistent_rb_tree<Key, Value, KeyOfValue, Compare>::flip_colors(
+    link_type h) {
+    h->red = !h->red;
+    h->left = mutable_node(h->left);
+    h->left->red = !h->left->red;
+    h->right = mutable_node(h->right);
+    h->right->red = !h->right->red;
+}
+
+// 假设 h 为红而 h->left 与 h->left->left 都为黑，使 h->left 或其孩子变红
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::link_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::move_red_left(
+    link_type h) {
+    flip_colors(h);
+    if (is_red(h->right->left)) {
+        h->right = rotate_right(h->right);
+        h = rotate_left(h);
+        flip_colors(h);
+    }
+    return h;
+}
+
+// 假设 h 为红而 h->right 与 h->right->left 都为黑，使 h->right 或其孩子变红
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::link_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::move_red_right(
+    link_type h) {
+    flip_colors(h);
+    if (is_red(h->left->left)) {
+        h = rotate_right(h);
+        flip_colors(h);
+    }
+    return h;
+}
+
+// 自底向上恢复左倾红黑树的性质
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::link_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::balance(link_type h) {
+    if (is_red(h->right) && !is_red(h->left))
+        h = rotate_left(h);
+    if (is_red(h->left) && is_red(h->left->left))
+        h = rotate_right(h);
+    if (is_red(h->left) && is_red(h->right))
+        flip_colors(h);
+    return h;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::link_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::insert_aux(
+    link_type h, const value_type& value) {
+    if (h == NULL)
+        return create_node(value);
+    if (key_compare(KeyOfValue()(value), key(h)))
+        h->left = insert_aux(mutable_node(h->left), value);
+    else
+        h->right = insert_aux(mutable_node(h->right), value);
+    return balance(h);
+}
+
+// 删除以 h 为根的子树中的最小节点，左倾红黑树中没有左孩子的节点也没有右孩子
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::link_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::erase_min(link_type h) {
+    if (h->left == NULL) {
+        release(h);
+        return NULL;
+    }
+    if (!is_red(h->left) && !is_red(h->left->left))
+        h = move_red_left(h);
+    h->left = erase_min(mutable_node(h->left));
+    return balance(h);
+}
+
+// k 必须存在于以 h 为根的子树中
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::link_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::erase_aux(
+    link_type h, const key_type& k) {
+    if (key_compare(k, key(h))) {
+        if (!is_red(h->left) && !is_red(h->left->left))
+            h = move_red_left(h);
+        h->left = erase_aux(mutable_node(h->left), k);
+    } else {
+        if (is_red(h->left))
+            h = rotate_right(h);
+        if (!key_compare(key(h), k) && h->right == NULL) {
+            release(h);
+            return NULL;
+        }
+        if (!is_red(h->right) && !is_red(h->right->left))
+            h = move_red_right(h);
+        if (!key_compare(key(h), k)) {
+            // 元素类型可能含 const 键而不能赋值，用右子树最小元素的副本替换 h
+            link_type x = create_node(node_type::minimum(h->right)->value);
+            x->right = erase_min(mutable_node(h->right));
+            x->red = h->red;
+            x->left = h->left;
+            h->left = NULL;
+            h->right = NULL;
+            release(h);
+            h = x;
+        } else {
+            h->right = erase_aux(mutable_node(h->right), k);
+        }
+    }
+    return balance(h);
+}
+
+// 已存在时不做任何复制；插入后重新查找一次以构造迭代器
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+std::pair<typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::iterator,
+          bool>
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::insert_unique(
+    const value_type& value) {
+    iterator it = find(KeyOfValue()(value));
+    if (it != end())
+        return std::pair<iterator, bool>(it, false);
+    root = insert_aux(mutable_node(root), value);
+    root->red = false;
+    ++node_count;
+    return std::pair<iterator, bool>(find(KeyOfValue()(value)), true);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::size_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::erase(const key_type& k) {
+    if (find(k) == end())
+        return 0;
+    root = mutable_node(root);
+    if (!is_red(root->left) && !is_red(root->right))
+        root->red = true;
+    root = erase_aux(root, k);
+    if (root != NULL)
+        root->red = false;
+    --node_count;
+    return 1;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::iterator
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::lower_bound(
+    const key_type& k) const {
+    iterator it;
+    for (link_type x = root; x != NULL;) {
+        if (!key_compare(key(x), k)) {
+            it.path[it.depth++] = x;
+            x = x->left;
+        } else {
+            x = x->right;
+        }
+    }
+    return it;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::iterator
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::upper_bound(
+    const key_type& k) const {
+    iterator it;
+    for (link_type x = root; x != NULL;) {
+        if (key_compare(k, key(x))) {
+            it.path[it.depth++] = x;
+            x = x->left;
+        } else {
+            x = x->right;
+        }
+    }
+    return it;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare>::iterator
+persistent_rb_tree<Key, Value, KeyOfValue, Compare>::find(
+    const key_type& k) const {
+    iterator it = lower_bound(k);
+    return (it == end() || key_compare(k, key(it.node()))) ? end() : it;
+}
+
+// 返回黑高，发现违反性质时置 ok 为 false
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+int persistent_rb_tree<Key, Value, KeyOfValue, Compare>::verify_aux(
+    link_type x, bool& ok) const {
+    if (x == NULL)
+        return 1;
+    if (x->refs.load() == 0 || is_red(x->right))
+        ok = false;
+    if (is_red(x) && is_red(x->left))
+        ok = false;
+    if (x->left && !key_compare(key(x->left), key(x)))
+        ok = false;
+    if (x->right && !key_compare(key(x), key(x->right)))
+        ok = false;
+    int lh = verify_aux(x->left, ok);
+    int rh = verify_aux(x->right, ok);
+    if (lh != rh)
+        ok = false;
+    return lh + (is_red(x) ? 0 : 1);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+bool persistent_rb_tree<Key, Value, KeyOfValue, Compare>::rb_verify() const {
+    if (root == NULL)
+        return node_count == 0;
+    bool ok = !is_red(root);
+    verify_aux(root, ok);
+    size_type n = 0;
+    for (iterator it = begin(); it != end(); ++it)
+        ++n;
+    return ok && n == node_count;
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_PERSISTENT_TREE_H_
@@ -1,10 +1,12 @@
 #if !defined(MYSTL_QUEUE_H_)
 #define MYSTL_QUEUE_H_
 
-#include "list.h"
+#include "circular_buffer.h"
 
 namespace mystl {
-template <typename T, typename Container = mystl::list<T>>
+// 默认底层容器为连续存储的 circular_buffer，入队出队不需要逐个分配节点
+// 也可以指定 list、deque 等提供 push_back 与 pop_front 的容器
+template <typename T, typename Container = mystl::circular_buffer<T>>
 class queue {
 public:
     using value_type        = typename Container::value_type;
@@ -2,13 +2,16 @@
 #define MYSTL_SET_H_
 
 #include <functional>
+#include "btree.h"
 #include "tree.h"
 
 namespace mystl {
-template <typename Key, typename Compare = std::less<Key>>
+// Rep 为底层的有序容器，默认为红黑树，也可以换成接口相同的 btree
+template <typename Key, typename Compare = std::less<Key>,
+          typename Rep = rb_tree<Key, Key, std::_Identity<Key>, Compare>>
 class set {
 private:
-    using rep_type = rb_tree<Key, Key, std::_Identity<Key>, Compare>;
+    using rep_type = Rep;
     rep_type tree;
 
 public:
@@ -25,8 +28,11 @@ public:
     using const_iterator    = typename rep_type::const_iterator;
     using difference_type   = typename rep_type::difference_type;
     using size_type         = typename rep_type::size_type;
+    using node_type         = typename rep_type::node_type;
 
     // 构造函数
+    set() : tree(Compare()) {}
+    explicit set(const Compare& comp) : tree(comp) {}
     template <typename InputIterator>
     set(InputIterator first, InputIterator last) : tree(Compare()) {
         tree.insert_unique(first, last);
@@ -36,8 +42,8 @@ public:
         : tree(comp) {
         tree.insert_unique(first, last);
     }
-    set(const set<Key, Compare>& x) : tree(x.tree) {}
-    set<Key, Compare>& operator=(const set<Key, Compare>& x) {
+    set(const set& x) : tree(x.tree) {}
+    set& operator=(const set& x) {
         tree = x.tree;
         return *this;
     }
@@ -49,7 +55,7 @@ public:
     bool            empty()      const { return tree.empty(); }
     size_type       size()       const { return tree.size(); }
     size_type       max_size()   const { return tree.max_size(); }
-    void            swap(set<Key, Compare>& x) { tree.swap(x.tree); }
+    void            swap(set& x) { tree.swap(x.tree); }
 
     std::pair<iterator, bool> insert(const value_type& x) {
         std::pair<typename rep_type::iterator, bool> p = tree.insert_unique(x);
@@ -58,8 +64,7 @@ public:
     }
 
     iterator insert(iterator position, const value_type& x) {
-        typedef typename rep_type::iterator rep_iterator;
-        return tree.insert_unique((rep_iterator&)position, x);
+        return tree.insert_unique(position, x);
     }
 
     template <typename InputIterator>
@@ -67,14 +72,21 @@ public:
         tree.insert_unique(first, last);
     }
 
+    // 节点句柄，用于在集合之间移动元素而不分配内存
+    node_type extract(iterator position) {
+        return tree.extract(position);
+    }
+    node_type extract(const key_type& x) { return tree.extract(x); }
+    std::pair<iterator, bool> insert(node_type&& nh) {
+        return tree.insert_unique(std::move(nh));
+    }
+
     void erase(iterator position) {
-        typedef typename rep_type::iterator rep_iterator;
-        tree.erase((rep_iterator&)position);
+        tree.erase(position);
     }
     size_type erase(const key_type& x) { return tree.erase(x); }
     void erase(iterator first, iterator last) {
-        typedef typename rep_type::iterator rep_iterator;
-        tree.erase((rep_iterator&)first, (rep_iterator&)last);
+        tree.erase(first, last);
     }
     void clear() { tree.clear(); }
 
@@ -89,12 +101,130 @@ public:
     std::pair<iterator, iterator> equal_range(const key_type& x) const {
         return tree.equal_range(x);
     }
+
+    // 整树操作，只重新链接节点，详见 rb_tree 中的说明
+    // split 把键不小于 k 的元素移入空的 x，其余操作结束后 x 为空
+    void join(set& x) { tree.join(x.tree); }
+    void split(const key_type& k, set& x) { tree.split(k, x.tree); }
+    void unite(set& x) { tree.unite(x.tree); }
+    void intersect(set& x) { tree.intersect(x.tree); }
+    void subtract(set& x) { tree.subtract(x.tree); }
+
+    // 第 k 小的元素（从 0 开始）与小于 x 的元素个数，均为 O(log n)
+    // 要求 Rep 带子树大小，即使用下面的 ranked_set
+    iterator select(size_type k) const { return tree.select(k); }
+    size_type rank(const key_type& x) const { return tree.rank(x); }
 }; // typename set
 
-template <typename Key, typename Compare>
-inline void swap(set<Key, Compare>& lhs, set<Key, Compare>& rhs) {
+template <typename Key, typename Compare, typename Rep>
+inline void swap(set<Key, Compare, Rep>& lhs, set<Key, Compare, Rep>& rhs) {
+    lhs.swap(rhs);
+}
+
+// 支持 select/rank 的 set，每个节点多带一个子树大小
+template <typename Key, typename Compare = std::less<Key>>
+using ranked_set =
+    set<Key, Compare, rb_tree<Key, Key, std::_Identity<Key>, Compare, true>>;
+
+// 允许键重复的 set，插入均走 insert_equal
+template <typename Key, typename Compare = std::less<Key>,
+          typename Rep = rb_tree<Key, Key, std::_Identity<Key>, Compare>>
+class multiset {
+private:
+    using rep_type = Rep;
+    rep_type tree;
+
+public:
+    using key_type      = Key;
+    using value_type    = Key;
+    using key_compare   = Compare;
+    using value_compare = Compare;
+
+    using pointer           = typename rep_type::const_pointer;
+    using const_point       = typename rep_type::const_pointer;
+    using reference         = typename rep_type::const_reference;
+    using const_reference   = typename rep_type::const_reference;
+    using iterator          = typename rep_type::const_iterator;
+    using const_iterator    = typename rep_type::const_iterator;
+    using difference_type   = typename rep_type::difference_type;
+    using size_type         = typename rep_type::size_type;
+    using node_type         = typename rep_type::node_type;
+
+    // 构造函数
+    multiset() : tree(Compare()) {}
+    explicit multiset(const Compare& comp) : tree(comp) {}
+    template <typename InputIterator>
+    multiset(InputIterator first, InputIterator last) : tree(Compare()) {
+        tree.insert_equal(first, last);
+    }
+    template <typename InputIterator>
+    multiset(InputIterator first, InputIterator last, const Compare& comp)
+        : tree(comp) {
+        tree.insert_equal(first, last);
+    }
+    multiset(const multiset& x) : tree(x.tree) {}
+    multiset& operator=(const multiset& x) {
+        tree = x.tree;
+        return *this;
+    }
+
+    key_compare     key_comp()   const { return tree.key_comp(); }
+    value_compare   value_comp() const { return tree.key_comp(); }
+    iterator        begin()      const { return tree.begin(); }
+    iterator        end()        const { return tree.end(); }
+    bool            empty()      const { return tree.empty(); }
+    size_type       size()       const { return tree.size(); }
+    size_type       max_size()   const { return tree.max_size(); }
+    void            swap(multiset& x) { tree.swap(x.tree); }
+
+    iterator insert(const value_type& x) { return tree.insert_equal(x); }
+
+    iterator insert(iterator position, const value_type& x) {
+        return tree.insert_equal(position, x);
+    }
+
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        tree.insert_equal(first, last);
+    }
+
+    node_type extract(iterator position) {
+        return tree.extract(position);
+    }
+    node_type extract(const key_type& x) { return tree.extract(x); }
+    iterator insert(node_type&& nh) { return tree.insert_equal(std::move(nh)); }
+
+    void erase(iterator position) {
+        tree.erase(position);
+    }
+    size_type erase(const key_type& x) { return tree.erase(x); }
+    void erase(iterator first, iterator last) {
+        tree.erase(first, last);
+    }
+    void clear() { tree.clear(); }
+
+    iterator find(const key_type& x) const { return tree.find(x); }
+    size_type count(const key_type& x) const { return tree.count(x); }
+    iterator lower_bound(const key_type& x) const {
+        return tree.lower_bound(x);
+    }
+    iterator upper_bound(const key_type& x) const {
+        return tree.upper_bound(x);
+    }
+    std::pair<iterator, iterator> equal_range(const key_type& x) const {
+        return tree.equal_range(x);
+    }
+}; // typename multiset
+
+template <typename Key, typename Compare, typename Rep>
+inline void swap(multiset<Key, Compare, Rep>& lhs,
+                 multiset<Key, Compare, Rep>& rhs) {
     lhs.swap(rhs);
 }
+
+// 以 B+ 树为底层容器的 set，查找时缓存未命中更少，但插入删除会使迭代器失效
+template <typename Key, typename Compare = std::less<Key>>
+using btree_set = set<Key, Compare, btree<Key, Key, std::_Identity<Key>, Compare>>;
 }  // namespace mystl
 
 #endif  // MYSTL_SET_H_
@@ -0,0 +1,168 @@
+#if !defined(MYSTL_SPSC_QUEUE_H_)
+#define MYSTL_SPSC_QUEUE_H_
+
+#include <atomic>
+#include "memory.h"
+
+/* 本头文件实现了一个定长的单生产者单消费者无锁环形队列
+ * 只允许一个线程 push，另一个线程 pop，二者之间不需要加锁
+ * 容量向上取整为 2 的幂，下标用掩码取模；构造时一次性分配全部空间，之后不再分配内存 */
+namespace mystl {
+
+// 缓存行大小，用于把生产者和消费者各自修改的变量隔开，避免伪共享
+const size_t cache_line_size = 64;
+
+// 向上取整到 2 的幂
+inline size_t round_up_pow2(size_t n) {
+    size_t result = 1;
+    while (result < n)
+        result <<= 1;
+    return result;
+}
+
+template <typename T, typename Alloc = alloc<T>>
+class spsc_queue {
+public:
+    using value_type        = T;
+    using pointer           = T*;
+    using reference         = T&;
+    using const_reference   = const T&;
+    using size_type         = size_t;
+
+protected:
+    // head 只由消费者写，tail 只由生产者写，下标单调递增，取模时才用掩码
+    // 两端各自缓存对方的下标，只有缓存显示队列满或空时才去读对方的缓存行
+    alignas(cache_line_size) std::atomic<size_type> head;
+    size_type tail_cache;
+    alignas(cache_line_size) std::atomic<size_type> tail;
+    size_type head_cache;
+    alignas(cache_line_size) pointer buffer;
+    size_type mask;
+
+    pointer slot(size_type index) const { return buffer + (index & mask); }
+
+public:
+    explicit spsc_queue(size_type n)
+        : head(0), tail_cache(0), tail(0), head_cache(0),
+          buffer(0), mask(round_up_pow2(n ? n : 1) - 1) {
+        buffer = Alloc::allocate(mask + 1);
+    }
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+    ~spsc_queue() {
+        size_type h = head.load(std::memory_order_relaxed);
+        size_type t = tail.load(std::memory_order_relaxed);
+        for (; h != t; ++h)
+            destroy(slot(h));
+        Alloc::deallocate(buffer, mask + 1);
+    }
+
+    /* 容量相关操作，size 与 empty 在并发时只是一个近似值 */
+    size_type capacity() const { return mask + 1; }
+    size_type size() const {
+        return tail.load(std::memory_order_acquire) -
+               head.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    bool full() const { return size() == capacity(); }
+
+    /* 生产者接口 */
+    bool try_push(const value_type& value);
+    size_type try_push(const value_type* first, size_type n);
+    void push(const value_type& value) {
+        while (!try_push(value))
+            ;
+    }
+
+    /* 消费者接口 */
+    pointer front();
+    bool try_pop(value_type& value);
+    size_type try_pop(value_type* result, size_type n);
+    void pop(value_type& value) {
+        while (!try_pop(value))
+            ;
+    }
+    void pop() {
+        size_type h = head.load(std::memory_order_relaxed);
+        destroy(slot(h));
+        head.store(h + 1, std::memory_order_release);
+    }
+};  // end spsc_queue
+
+template <typename T, typename Alloc>
+bool spsc_queue<T, Alloc>::try_push(const value_type& value) {
+    size_type t = tail.load(std::memory_order_relaxed);
+    if (t - head_cache > mask) {
+        head_cache = head.load(std::memory_order_acquire);
+        if (t - head_cache > mask)
+            return false;
+    }
+    construct(slot(t), value);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+// 批量写入，返回实际写入的个数，只在最后发布一次 tail
+template <typename T, typename Alloc>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::try_push(
+    const value_type* first, size_type n) {
+    size_type t = tail.load(std::memory_order_relaxed);
+    size_type free_slots = capacity() - (t - head_cache);
+    if (free_slots < n) {
+        head_cache = head.load(std::memory_order_acquire);
+        free_slots = capacity() - (t - head_cache);
+        if (n > free_slots)
+            n = free_slots;
+    }
+    for (size_type i = 0; i != n; ++i)
+        construct(slot(t + i), first[i]);
+    tail.store(t + n, std::memory_order_release);
+    return n;
+}
+
+// 返回队首元素的指针，队列为空时返回空指针
+template <typename T, typename Alloc>
+typename spsc_queue<T, Alloc>::pointer spsc_queue<T, Alloc>::front() {
+    size_type h = head.load(std::memory_order_relaxed);
+    if (h == tail_cache) {
+        tail_cache = tail.load(std::memory_order_acquire);
+        if (h == tail_cache)
+            return 0;
+    }
+    return slot(h);
+}
+
+template <typename T, typename Alloc>
+bool spsc_queue<T, Alloc>::try_pop(value_type& value) {
+    pointer ptr = front();
+    if (ptr == 0)
+        return false;
+    value = std::move(*ptr);
+    pop();
+    return true;
+}
+
+// 批量读出，返回实际读出的个数，只在最后发布一次 head
+template <typename T, typename Alloc>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::try_pop(
+    value_type* result, size_type n) {
+    size_type h = head.load(std::memory_order_relaxed);
+    size_type avail = tail_cache - h;
+    if (avail < n) {
+        tail_cache = tail.load(std::memory_order_acquire);
+        avail = tail_cache - h;
+        if (n > avail)
+            n = avail;
+    }
+    for (size_type i = 0; i != n; ++i) {
+        pointer ptr = slot(h + i);
+        result[i] = std::move(*ptr);
+        destroy(ptr);
+    }
+    head.store(h + n, std::memory_order_release);
+    return n;
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_SPSC_QUEUE_H_
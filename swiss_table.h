@@ -0,0 +1,517 @@
+#if !defined(MYSTL_SWISS_TABLE_H_)
+#define MYSTL_SWISS_TABLE_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+#include "memory.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MYSTL_SWISS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/* 本头文件实现了开放寻址的哈希表 swiss_table，供 unordered_set 与 unordered_map 使用
+ * 元素直接存放在连续的槽数组中，另有一个等长的控制字节数组：
+ * 空槽为 empty，删除过的槽为 deleted，占用的槽保存哈希值的低 7 位 (h2)
+ * 查找时以 16 个控制字节为一组，用 SSE2 一次比较出组内所有 h2 相同的槽，
+ * 只有这些槽才需要调用 KeyEqual，遇到含空槽的组即可确定查找失败
+ * 容量为 2^k - 1，控制字节数组末尾是一个 sentinel 和前 15 个字节的副本，
+ * 因此从任意位置读取一组都不会越界，sentinel 也用作迭代器的终点 */
+namespace mystl {
+
+using swiss_ctrl_type = signed char;
+const swiss_ctrl_type swiss_empty    = -128;
+const swiss_ctrl_type swiss_deleted  = -2;
+const swiss_ctrl_type swiss_sentinel = -1;
+
+// 每组的控制字节数，match 系列函数返回的位掩码中第 i 位对应组内第 i 个槽
+struct swiss_group {
+    enum { width = 16 };
+
+#if defined(MYSTL_SWISS_SSE2)
+    __m128i ctrl;
+
+    explicit swiss_group(const swiss_ctrl_type* pos)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    uint32_t match(swiss_ctrl_type h2) const {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl));
+    }
+    uint32_t match_empty() const { return match(swiss_empty); }
+    // empty 与 deleted 都小于 sentinel
+    uint32_t match_empty_or_deleted() const {
+        return _mm_movemask_epi8(
+            _mm_cmpgt_epi8(_mm_set1_epi8(swiss_sentinel), ctrl));
+    }
+#else
+    swiss_ctrl_type ctrl[width];
+
+    explicit swiss_group(const swiss_ctrl_type* pos) {
+        memcpy(ctrl, pos, width);
+    }
+
+    uint32_t match(swiss_ctrl_type h2) const {
+        uint32_t mask = 0;
+        for (int i = 0; i != width; ++i)
+            mask |= uint32_t(ctrl[i] == h2) << i;
+        return mask;
+    }
+    uint32_t match_empty() const { return match(swiss_empty); }
+    uint32_t match_empty_or_deleted() const {
+        uint32_t mask = 0;
+        for (int i = 0; i != width; ++i)
+            mask |= uint32_t(ctrl[i] < swiss_sentinel) << i;
+        return mask;
+    }
+#endif
+};
+
+// 位掩码中最低位与最高位的 1 的序号，mask 不能为 0
+inline int swiss_lowest_bit(uint32_t mask) {
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    int n = 0;
+    for (; !(mask & 1); mask >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+inline int swiss_leading_zeros(uint32_t mask) {
+    int n = 0;
+    for (uint32_t bit = 1u << (swiss_group::width - 1); !(mask & bit);
+         bit >>= 1)
+        ++n;
+    return n;
+}
+
+// 打乱用户哈希值的各位，std::hash 对整数是恒等映射，不混合的话 h2 全部相同
+inline size_t swiss_mix(size_t h) {
+    const size_t shift = sizeof(size_t) * 4;
+    h ^= h >> (shift - 3);
+    h *= size_t(0x9E3779B97F4A7C15ULL);
+    h ^= h >> shift;
+    return h;
+}
+
+// 判断 Hash 与 KeyEqual 是否声明了 is_transparent，用于异构查找
+template <typename...>
+struct swiss_void {
+    using type = void;
+};
+
+template <typename T, typename = void>
+struct is_transparent : std::false_type {};
+
+template <typename T>
+struct is_transparent<
+    T, typename swiss_void<typename T::is_transparent>::type>
+    : std::true_type {};
+
+// 迭代器只保存控制字节与槽的指针，++ 时跳过非占用的槽，停在 sentinel 处即为 end
+template <typename Value, typename Ref, typename Ptr>
+struct swiss_iterator {
+    using value_type        = Value;
+    using reference         = Ref;
+    using pointer           = Ptr;
+    using difference_type   = ptrdiff_t;
+    using iterator_category = forward_iterator_tag;
+    using iterator          = swiss_iterator<Value, Value&, Value*>;
+    using self              = swiss_iterator<Value, Ref, Ptr>;
+
+    const swiss_ctrl_type* ctrl;
+    Value* slot;
+
+    swiss_iterator() : ctrl(0), slot(0) {}
+    swiss_iterator(const swiss_ctrl_type* c, Value* s) : ctrl(c), slot(s) {}
+    template <typename Iter, typename = typename std::enable_if<
+                                 std::is_same<Iter, iterator>::value>::type>
+    swiss_iterator(const Iter& x) : ctrl(x.ctrl), slot(x.slot) {}
+
+    // 跳到下一个占用的槽或 sentinel
+    void skip_free() {
+        while (*ctrl < swiss_sentinel) {
+            ++ctrl;
+            ++slot;
+        }
+    }
+
+    reference operator*() const { return *slot; }
+    pointer operator->() const { return slot; }
+    self& operator++() {
+        ++ctrl;
+        ++slot;
+        skip_free();
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    bool operator==(const self& x) const { return ctrl == x.ctrl; }
+    bool operator!=(const self& x) const { return ctrl != x.ctrl; }
+};
+
+template <typename Value, typename Key, typename ExtractKey, typename Hash,
+          typename KeyEqual>
+class swiss_table {
+public:
+    using key_type          = Key;
+    using value_type        = Value;
+    using hasher            = Hash;
+    using key_equal         = KeyEqual;
+    using pointer           = value_type*;
+    using const_pointer     = const value_type*;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    using iterator          = swiss_iterator<Value, Value&, Value*>;
+    using const_iterator = swiss_iterator<Value, const Value&, const Value*>;
+
+private:
+    using slot_alloc = alloc<Value>;
+    using ctrl_alloc = alloc<swiss_ctrl_type>;
+    enum { cloned_bytes = swiss_group::width - 1 };
+    enum { min_capacity = 15 };
+
+    swiss_ctrl_type* ctrl;
+    Value* slots;
+    size_type capacity;     // 0 或 2^k - 1，同时用作掩码
+    size_type num_elements;
+    size_type growth_left;  // 还能占用多少个空槽，最大负载因子为 7/8
+    Hash hash;
+    KeyEqual equals;
+
+    static size_type max_load(size_type cap) { return cap - cap / 8; }
+    static size_type ctrl_bytes(size_type cap) {
+        return cap + 1 + cloned_bytes;
+    }
+
+    // 能容纳 n 个元素的最小容量
+    static size_type capacity_for(size_type n) {
+        size_type cap = min_capacity;
+        while (max_load(cap) < n)
+            cap = cap * 2 + 1;
+        return cap;
+    }
+
+    template <typename K>
+    size_type hash_of(const K& k) const {
+        return swiss_mix(hash(k));
+    }
+    static swiss_ctrl_type h2(size_type h) {
+        return swiss_ctrl_type(h & 0x7f);
+    }
+
+    // 同时写入副本，使组读取在末尾回绕
+    void set_ctrl(size_type i, swiss_ctrl_type h) {
+        ctrl[i] = h;
+        ctrl[((i - cloned_bytes) & capacity) + (cloned_bytes & capacity)] = h;
+    }
+
+    void init(size_type cap);
+    void free_storage();
+    void resize(size_type new_cap);
+    void rehash_and_grow();
+    size_type find_first_non_full(size_type h) const;
+    template <typename K>
+    size_type find_index(const K& k, size_type h) const;
+    void erase_at(size_type i);
+
+public:
+    explicit swiss_table(const Hash& hf = Hash(),
+                         const KeyEqual& eql = KeyEqual())
+        : ctrl(0),
+          slots(0),
+          capacity(0),
+          num_elements(0),
+          growth_left(0),
+          hash(hf),
+          equals(eql) {}
+    swiss_table(const swiss_table& x);
+    swiss_table& operator=(const swiss_table& x) {
+        if (this != &x) {
+            swiss_table tmp(x);
+            swap(tmp);
+        }
+        return *this;
+    }
+    ~swiss_table() {
+        clear();
+        free_storage();
+    }
+
+    hasher hash_function() const { return hash; }
+    key_equal key_eq() const { return equals; }
+
+    iterator begin() {
+        if (num_elements == 0)
+            return end();
+        iterator it(ctrl, slots);
+        it.skip_free();
+        return it;
+    }
+    const_iterator begin() const {
+        return const_cast<swiss_table*>(this)->begin();
+    }
+    iterator end() { return iterator(ctrl + capacity, slots + capacity); }
+    const_iterator end() const {
+        return const_cast<swiss_table*>(this)->end();
+    }
+
+    bool empty() const { return num_elements == 0; }
+    size_type size() const { return num_elements; }
+    size_type max_size() const { return size_type(-1) / sizeof(Value); }
+    size_type bucket_count() const { return capacity; }
+    float load_factor() const {
+        return capacity ? float(num_elements) / capacity : 0.0f;
+    }
+    float max_load_factor() const { return 0.875f; }
+
+    void swap(swiss_table& x) {
+        std::swap(ctrl, x.ctrl);
+        std::swap(slots, x.slots);
+        std::swap(capacity, x.capacity);
+        std::swap(num_elements, x.num_elements);
+        std::swap(growth_left, x.growth_left);
+        std::swap(hash, x.hash);
+        std::swap(equals, x.equals);
+    }
+
+    // 预留至少能放下 n 个元素的空间，之后插入 n 个元素不会再重新散列
+    void reserve(size_type n) {
+        if (n > num_elements + growth_left)
+            resize(capacity_for(n));
+    }
+    void rehash(size_type n) {
+        if (n > capacity)
+            reserve(max_load(n));
+    }
+
+    // 键不存在时才调用 make(ptr) 在槽中构造元素，返回元素位置与是否插入
+    template <typename K, typename Make>
+    std::pair<iterator, bool> find_or_insert(const K& k, Make make);
+
+    template <typename V>
+    std::pair<iterator, bool> insert_unique(V&& v) {
+        return find_or_insert(
+            ExtractKey()(v),
+            [&v](Value* p) { new (p) Value(std::forward<V>(v)); });
+    }
+    template <typename InputIterator>
+    void insert_unique(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert_unique(*first);
+    }
+
+    void erase(iterator position) { erase_at(position.slot - slots); }
+    void erase(const_iterator position) {
+        erase_at(position.slot - slots);
+    }
+    template <typename K>
+    size_type erase(const K& k) {
+        if (num_elements == 0)
+            return 0;
+        size_type i = find_index(k, hash_of(k));
+        if (i == capacity)
+            return 0;
+        erase_at(i);
+        return 1;
+    }
+    void clear();
+
+    template <typename K>
+    iterator find(const K& k) {
+        if (num_elements == 0)
+            return end();
+        size_type i = find_index(k, hash_of(k));
+        return iterator(ctrl + i, slots + i);
+    }
+    template <typename K>
+    const_iterator find(const K& k) const {
+        return const_cast<swiss_table*>(this)->find(k);
+    }
+    template <typename K>
+    size_type count(const K& k) const {
+        return find(k) == end() ? 0 : 1;
+    }
+};
+
+template <typename V, typename K, typename Ex, typename H, typename Eq>
+swiss_table<V, K, Ex, H, Eq>::swiss_table(const swiss_table& x)
+    : ctrl(0),
+      slots(0),
+      capacity(0),
+      num_elements(0),
+      growth_left(0),
+      hash(x.hash),
+      equals(x.equals) {
+    reserve(x.size());
+    try {
+        for (const_iterator it = x.begin(); it != x.end(); ++it)
+            insert_unique(*it);
+    } catch (...) {
+        clear();
+        free_storage();
+        throw;
+    }
+}
+
+template <typename V, typename K, typename Ex, typename H, typename Eq>
+void swiss_table<V, K, Ex, H, Eq>::init(size_type cap) {
+    ctrl = ctrl_alloc::allocate(ctrl_bytes(cap));
+    try {
+        slots = slot_alloc::allocate(cap);
+    } catch (...) {
+        ctrl_alloc::deallocate(ctrl, ctrl_bytes(cap));
+        ctrl = 0;
+        throw;
+    }
+    memset(ctrl, swiss_empty, ctrl_bytes(cap));
+    ctrl[cap] = swiss_sentinel;
+    capacity = cap;
+    growth_left = max_load(cap) - num_elements;
+}
+
+template <typename V, typename K, typename Ex, typename H, typename Eq>
+void swiss_table<V, K, Ex, H, Eq>::free_storage() {
+    if (capacity != 0) {
+        ctrl_alloc::deallocate(ctrl, ctrl_bytes(capacity));
+        slot_alloc::deallocate(slots, capacity);
+    }
+    ctrl = 0;
+    slots = 0;
+    capacity = 0;
+    growth_left = 0;
+}
+
+// 换用容量为 new_cap 的新数组，把元素逐个移入并丢弃所有 deleted 标记
+template <typename V, typename K, typename Ex, typename H, typename Eq>
+void swiss_table<V, K, Ex, H, Eq>::resize(size_type new_cap) {
+    swiss_ctrl_type* old_ctrl = ctrl;
+    V* old_slots = slots;
+    size_type old_cap = capacity;
+    init(new_cap);
+    for (size_type i = 0; i != old_cap; ++i) {
+        if (old_ctrl[i] >= 0) {
+            size_type h = hash_of(Ex()(old_slots[i]));
+            size_type j = find_first_non_full(h);
+            set_ctrl(j, h2(h));
+            new (slots + j) V(std::move(old_slots[i]));
+            mystl::destroy(old_slots + i);
+        }
+    }
+    growth_left = max_load(capacity) - num_elements;
+    if (old_cap != 0) {
+        ctrl_alloc::deallocate(old_ctrl, ctrl_bytes(old_cap));
+        slot_alloc::deallocate(old_slots, old_cap);
+    }
+}
+
+// 删除标记过多时原容量重建即可，否则容量翻倍
+template <typename V, typename K, typename Ex, typename H, typename Eq>
+void swiss_table<V, K, Ex, H, Eq>::rehash_and_grow() {
+    if (capacity == 0)
+        resize(min_capacity);
+    else if (capacity > min_capacity && num_elements * 2 <= max_load(capacity))
+        resize(capacity);
+    else
+        resize(capacity * 2 + 1);
+}
+
+// 沿探测序列找第一个空槽或删除过的槽，表中总有空槽，因此一定能找到
+template <typename V, typename K, typename Ex, typename H, typename Eq>
+typename swiss_table<V, K, Ex, H, Eq>::size_type
+swiss_table<V, K, Ex, H, Eq>::find_first_non_full(size_type h) const {
+    size_type offset = (h >> 7) & capacity;
+    for (size_type step = swiss_group::width;; step += swiss_group::width) {
+        uint32_t mask = swiss_group(ctrl + offset).match_empty_or_deleted();
+        if (mask)
+            return (offset + swiss_lowest_bit(mask)) & capacity;
+        offset = (offset + step) & capacity;
+    }
+}
+
+// 以组为单位做三角数探测，能遍历到所有组；找不到时返回 capacity
+template <typename V, typename K, typename Ex, typename H, typename Eq>
+template <typename Key>
+typename swiss_table<V, K, Ex, H, Eq>::size_type
+swiss_table<V, K, Ex, H, Eq>::find_index(const Key& k, size_type h) const {
+    size_type offset = (h >> 7) & capacity;
+    swiss_ctrl_type tag = h2(h);
+    for (size_type step = swiss_group::width;; step += swiss_group::width) {
+        swiss_group g(ctrl + offset);
+        for (uint32_t mask = g.match(tag); mask; mask &= mask - 1) {
+            size_type i = (offset + swiss_lowest_bit(mask)) & capacity;
+            if (equals(Ex()(slots[i]), k))
+                return i;
+        }
+        if (g.match_empty())
+            return capacity;
+        offset = (offset + step) & capacity;
+    }
+}
+
+template <typename V, typename K, typename Ex, typename H, typename Eq>
+template <typename Key, typename Make>
+std::pair<typename swiss_table<V, K, Ex, H, Eq>::iterator, bool>
+swiss_table<V, K, Ex, H, Eq>::find_or_insert(const Key& k, Make make) {
+    size_type h = hash_of(k);
+    if (num_elements != 0) {
+        size_type i = find_index(k, h);
+        if (i != capacity)
+            return std::pair<iterator, bool>(iterator(ctrl + i, slots + i),
+                                             false);
+    }
+    size_type i = capacity == 0 ? 0 : find_first_non_full(h);
+    if (growth_left == 0 && (capacity == 0 || ctrl[i] != swiss_deleted)) {
+        rehash_and_grow();
+        i = find_first_non_full(h);
+    }
+    make(slots + i);
+    if (ctrl[i] == swiss_empty)
+        --growth_left;
+    set_ctrl(i, h2(h));
+    ++num_elements;
+    return std::pair<iterator, bool>(iterator(ctrl + i, slots + i), true);
+}
+
+/* 若该槽前后两组中的空槽相距不足一组，说明没有探测序列曾经越过它，
+ * 可以直接标记为 empty，否则只能标记为 deleted，留到下次重建时清除 */
+template <typename V, typename K, typename Ex, typename H, typename Eq>
+void swiss_table<V, K, Ex, H, Eq>::erase_at(size_type i) {
+    mystl::destroy(slots + i);
+    --num_elements;
+    size_type before = (i - swiss_group::width) & capacity;
+    uint32_t empty_before = swiss_group(ctrl + before).match_empty();
+    uint32_t empty_after = swiss_group(ctrl + i).match_empty();
+    bool never_full = empty_before && empty_after &&
+                      swiss_lowest_bit(empty_after) +
+                              swiss_leading_zeros(empty_before) <
+                          swiss_group::width;
+    set_ctrl(i, never_full ? swiss_empty : swiss_deleted);
+    if (never_full)
+        ++growth_left;
+}
+
+template <typename V, typename K, typename Ex, typename H, typename Eq>
+void swiss_table<V, K, Ex, H, Eq>::clear() {
+    if (capacity == 0)
+        return;
+    for (size_type i = 0; i != capacity; ++i)
+        if (ctrl[i] >= 0)
+            mystl::destroy(slots + i);
+    memset(ctrl, swiss_empty, ctrl_bytes(capacity));
+    ctrl[capacity] = swiss_sentinel;
+    num_elements = 0;
+    growth_left = max_load(capacity);
+}
+}  // namespace mystl
+
+#endif  // MYSTL_SWISS_TABLE_H_
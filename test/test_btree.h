@@ -0,0 +1,115 @@
+#if !defined(MYSTL_TEST_BTREE_H_)
+#define MYSTL_TEST_BTREE_H_
+
+#include <stdlib.h>
+#include <time.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "test.h"
+#include "../set.h"
+
+namespace mystl {
+
+void btree_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[----------------- Run container test : btree "
+                 "------------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    int a[] = {5, 3, 9, 1, 7, 3, 11};
+    mystl::btree_set<int> s1(a, a + 7);
+    PRINT(s1);
+    FUN_VALUE(s1.size());
+    FUN_VALUE(*s1.find(7));
+    FUN_VALUE((s1.find(4) == s1.end()));
+    FUN_VALUE(*s1.lower_bound(4));
+    FUN_VALUE(*s1.upper_bound(9));
+    FUN_VALUE(s1.count(3));
+    FUN_AFTER(s1, s1.insert(4));
+    FUN_AFTER(s1, s1.erase(9));
+    FUN_AFTER(s1, s1.erase(s1.begin()));
+    FUN_VALUE(*--s1.end());
+
+    // 与 rb_tree 对照随机插入删除，检查结构与内容
+    mystl::btree<int, int, std::_Identity<int>, std::less<int>> t1;
+    mystl::rb_tree<int, int, std::_Identity<int>, std::less<int>> t2;
+    srand(2020);
+    bool ok = true;
+    for (int i = 0; i != 200000 && ok; ++i) {
+        int value = rand() % 5000;
+        switch (rand() % 4) {
+            case 0:
+                t1.insert_equal(value);
+                t2.insert_equal(value);
+                break;
+            case 1:
+                ok = t1.erase(value) == t2.erase(value);
+                break;
+            default:
+                ok = t1.insert_unique(value).second ==
+                     t2.insert_unique(value).second;
+        }
+        if (i % 1000 == 0)
+            ok = ok && t1.verify() && t1.size() == t2.size() &&
+                 std::equal(t1.begin(), t1.end(), t2.begin());
+    }
+    std::cout << " btree consistent with rb_tree : " << ok << "\n";
+
+    // 元素带有堆内存时，节点分裂与合并要正确地搬动元素
+    mystl::btree_set<std::string> s2;
+    for (int i = 0; i != 2000; ++i)
+        s2.insert(std::string(20, 'k') + std::to_string(10000 + i));
+    for (int i = 0; i != 1000; ++i)
+        s2.erase(s2.begin());
+    FUN_VALUE(s2.size());
+    FUN_VALUE(*s2.begin());
+    s2.insert(s2.end(), std::string(20, 'z'));
+    s2.erase(s2.begin(), s2.find(std::string(20, 'z')));
+    FUN_VALUE(s2.size());
+    FUN_VALUE(*s2.begin());
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+}
+
+void btree_find_test() {
+    // 随机查找时比较两种底层容器
+    const int count = 4000000;
+    std::vector<int> keys;
+    srand(2020);
+    for (int i = 0; i != count; ++i)
+        keys.push_back(rand());
+    mystl::set<int> s1;
+    mystl::btree_set<int> s2;
+    clock_t start = clock();
+    for (int i = 0; i != count; ++i)
+        s1.insert(keys[i]);
+    clock_t end = clock();
+    std::cout << "Time to insert " << count
+              << " numbers into set over rb_tree: " << end - start << std::endl;
+    start = clock();
+    for (int i = 0; i != count; ++i)
+        s2.insert(keys[i]);
+    end = clock();
+    std::cout << "Time to insert " << count
+              << " numbers into set over btree: " << end - start << std::endl;
+
+    size_t found1 = 0, found2 = 0;
+    start = clock();
+    for (int i = 0; i != count; ++i)
+        found1 += s1.find(keys[size_t(i) * 7919 % count]) != s1.end();
+    end = clock();
+    std::cout << "Time to find " << count
+              << " numbers in set over rb_tree: " << end - start << std::endl;
+    start = clock();
+    for (int i = 0; i != count; ++i)
+        found2 += s2.find(keys[size_t(i) * 7919 % count]) != s2.end();
+    end = clock();
+    std::cout << "Time to find " << count
+              << " numbers in set over btree: " << end - start << std::endl;
+    std::cout << " result equal : " << (found1 == found2) << "\n";
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_BTREE_H_
@@ -0,0 +1,109 @@
+#if !defined(MYSTL_TEST_CIRCULAR_BUFFER_H_)
+#define MYSTL_TEST_CIRCULAR_BUFFER_H_
+
+#include <time.h>
+#include <iostream>
+#include <string>
+#include "test.h"
+#include "../circular_buffer.h"
+#include "../deque.h"
+#include "../list.h"
+#include "../queue.h"
+
+namespace mystl {
+
+// 队列保持 depth 个元素，反复入队出队 count 次，返回耗时
+template <typename Queue>
+clock_t queue_churn(size_t depth, size_t count) {
+    Queue q;
+    clock_t start = clock();
+    for (size_t i = 0; i != depth; ++i)
+        q.push(i);
+    for (size_t i = 0; i != count; ++i) {
+        q.push(i);
+        q.pop();
+    }
+    return clock() - start;
+}
+
+void circular_buffer_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[------------ Run container test : circular_buffer "
+                 "-------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    int a[] = {1, 2, 3, 4, 5};
+    mystl::circular_buffer<int> c1;
+    mystl::circular_buffer<int> c2(10);
+    mystl::circular_buffer<int> c3(10, 1);
+    mystl::circular_buffer<int> c4(a, a + 5);
+    mystl::circular_buffer<int> c5(c4);
+    mystl::circular_buffer<int> c6 = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    c1 = c3;
+    PRINT(c1);
+    PRINT(c2);
+    PRINT(c3);
+    PRINT(c4);
+    PRINT(c5);
+    PRINT(c6);
+    FUN_AFTER(c1, c1.push_back(6));
+    FUN_AFTER(c1, c1.push_front(8));
+    FUN_AFTER(c1, c1.pop_back());
+    FUN_AFTER(c1, c1.pop_front());
+    FUN_AFTER(c1, c1.swap(c4));
+    FUN_VALUE(*c1.begin());
+    FUN_VALUE(*(c1.end() - 1));
+    FUN_VALUE(*(2 + c1.begin()));
+    FUN_VALUE((c1.end() > c1.begin()));
+    FUN_VALUE((c1.begin() <= c1.begin()));
+    FUN_VALUE((c1.begin() >= c1.end()));
+    FUN_VALUE(*c1.rbegin());
+    FUN_VALUE(c1.front());
+    FUN_VALUE(c1.back());
+    FUN_VALUE(c1[2]);
+    FUN_VALUE(c1.size());
+    FUN_VALUE(c1.capacity());
+    FUN_AFTER(c1, c1.reserve(40));
+    FUN_VALUE(c1.capacity());
+    FUN_AFTER(c1, for (int i = 0; i < 20; ++i) c1.push_front(i));
+    FUN_VALUE((c1.begin() + 3 >= c1.end() - 3));
+    FUN_VALUE((c1.end() - 1 > c1.begin()));
+    FUN_AFTER(c1, c1.clear());
+    FUN_VALUE(c1.size());
+
+    // 满时插入容器自身的元素，扩容后该元素仍须有效
+    mystl::circular_buffer<int> c7(8, 100);
+    mystl::circular_buffer<int> c8(8, 200);
+    c7.push_back(c7.front());
+    c8.push_front(c8.back());
+    FUN_VALUE(c7.back());
+    FUN_VALUE(c8.front());
+    mystl::queue<std::string> q1;
+    for (int i = 0; i < 20; ++i)
+        q1.push(std::string(i + 1, 'a'));
+    q1.pop();
+    FUN_VALUE(q1.front());
+    FUN_VALUE(q1.size());
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+
+    const size_t depth = 1000;
+    const size_t count = 10000000;
+    std::cout << "Time to push and pop " << count
+              << " numbers in queue with circular_buffer: "
+              << queue_churn<mystl::queue<size_t>>(depth, count) << std::endl;
+    std::cout << "Time to push and pop " << count
+              << " numbers in queue with deque: "
+              << queue_churn<mystl::queue<size_t, mystl::deque<size_t>>>(
+                     depth, count)
+              << std::endl;
+    std::cout << "Time to push and pop " << count
+              << " numbers in queue with list: "
+              << queue_churn<mystl::queue<size_t, mystl::list<size_t>>>(
+                     depth, count)
+              << std::endl;
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_CIRCULAR_BUFFER_H_
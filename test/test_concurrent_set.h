@@ -0,0 +1,181 @@
+#if !defined(MYSTL_TEST_CONCURRENT_SET_H_)
+#define MYSTL_TEST_CONCURRENT_SET_H_
+
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+#include "test.h"
+#include "../concurrent_set.h"
+#include "../set.h"
+
+namespace mystl {
+
+// 用加锁的 set 作对照，接口与 concurrent_set 的读写接口相同
+class locked_set {
+public:
+    bool insert(int value) {
+        std::lock_guard<std::mutex> lock(m);
+        return s.insert(value).second;
+    }
+    size_t erase(int value) {
+        std::lock_guard<std::mutex> lock(m);
+        return s.erase(value);
+    }
+    size_t count(int value) const {
+        std::lock_guard<std::mutex> lock(m);
+        return s.count(value);
+    }
+
+private:
+    mutable std::mutex m;
+    mystl::set<int> s;
+};
+
+// readers 个读者各查找 count 次，同时一个写者不停插入删除，返回耗时(ms)
+template <typename Set>
+long long concurrent_read_write(Set& s, size_t readers, size_t count,
+                                int range) {
+    std::atomic<bool> done(false);
+    std::atomic<size_t> found(0);
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    std::thread writer([&s, &done, range] {
+        std::minstd_rand gen(2020);
+        while (!done.load(std::memory_order_relaxed)) {
+            int value = gen() % range;
+            if (!s.insert(value))
+                s.erase(value);
+        }
+    });
+    for (size_t t = 0; t != readers; ++t) {
+        workers.emplace_back([&s, &found, t, count, range] {
+            std::minstd_rand gen(t + 1);
+            size_t local = 0;
+            for (size_t i = 0; i != count; ++i)
+                local += s.count(gen() % range);
+            found += local;
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    auto end = std::chrono::steady_clock::now();
+    done = true;
+    writer.join();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+        .count();
+}
+
+void concurrent_set_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[------------ Run container test : concurrent_set "
+                 "--------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    int a[] = {5, 3, 9, 1, 7, 3, 11};
+    int x = 0;
+    mystl::concurrent_set<int> s1;
+    s1.insert(a, a + 7);
+    FUN_VALUE(s1.size());
+    FUN_VALUE(s1.insert(4));
+    FUN_VALUE(s1.insert(4));
+    FUN_VALUE(s1.erase(9));
+    FUN_VALUE(s1.erase(9));
+    FUN_VALUE(s1.count(7));
+    FUN_VALUE(s1.lower_bound(8, x));
+    FUN_VALUE(x);
+    FUN_VALUE(s1.lower_bound(12, x));
+    std::cout << " s1 :";
+    s1.for_each([](int v) { std::cout << " " << v; });
+    std::cout << "\n";
+    s1.clear();
+    FUN_VALUE(s1.empty());
+
+    // 单线程下与 std::set 对照随机插入删除
+    mystl::concurrent_set<int> s2;
+    std::set<int> s3;
+    srand(2020);
+    bool ok = true;
+    for (int i = 0; i != 200000 && ok; ++i) {
+        int value = rand() % 5000;
+        if (rand() % 3 == 0)
+            ok = s2.erase(value) == s3.erase(value);
+        else
+            ok = s2.insert(value) == s3.insert(value).second;
+        if (i % 1000 == 0) {
+            std::set<int>::iterator it = s3.lower_bound(value);
+            ok = ok && s2.lower_bound(value, x) == (it != s3.end()) &&
+                 (it == s3.end() || x == *it) && s2.size() == s3.size();
+        }
+    }
+    std::vector<int> v;
+    s2.for_each([&v](int value) { v.push_back(value); });
+    ok = ok && v.size() == s3.size() &&
+         std::equal(s3.begin(), s3.end(), v.begin());
+    std::cout << " concurrent_set consistent with std::set : " << ok << "\n";
+
+    // 偶数始终在集合中，写者反复插入删除奇数，读者必须总能找到偶数
+    mystl::concurrent_set<int> s4;
+    const int range = 20000;
+    for (int i = 0; i < range; i += 2)
+        s4.insert(i);
+    std::atomic<bool> done(false);
+    std::atomic<size_t> errors(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t != 4; ++t) {
+        readers.emplace_back([&s4, &done, &errors, t] {
+            std::minstd_rand gen(t + 1);
+            int result = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                int value = gen() % range & ~1;
+                if (s4.count(value) != 1 || !s4.lower_bound(value, result) ||
+                    result != value)
+                    ++errors;
+            }
+        });
+    }
+    srand(2020);
+    for (int i = 0; i != 200000; ++i) {
+        int value = rand() % range | 1;
+        if (!s4.insert(value))
+            s4.erase(value);
+    }
+    done = true;
+    for (auto& r : readers)
+        r.join();
+    std::cout << " readers never miss stable keys : " << (errors == 0)
+              << "\n";
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+
+    // 读多写少：一个写者不停更新，比较 concurrent_set 与加锁的 set
+    const size_t count = 1000000;
+    const int key_range = 100000;
+    size_t max_threads = std::thread::hardware_concurrency();
+    if (max_threads < 4)
+        max_threads = 4;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        mystl::concurrent_set<int> cs;
+        locked_set ls;
+        for (int i = 0; i < key_range; i += 2) {
+            cs.insert(i);
+            ls.insert(i);
+        }
+        std::cout << "Time for " << threads << " readers to find " << count
+                  << " numbers each beside one writer, locked set: "
+                  << concurrent_read_write(ls, threads, count, key_range)
+                  << " ms, concurrent_set: "
+                  << concurrent_read_write(cs, threads, count, key_range)
+                  << " ms" << std::endl;
+    }
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_CONCURRENT_SET_H_
@@ -0,0 +1,179 @@
+#if !defined(MYSTL_TEST_DEQUE_H_)
+#define MYSTL_TEST_DEQUE_H_
+
+#include <stddef.h>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "test.h"
+#include "../deque.h"
+
+namespace mystl {
+
+// 记录每次分配的大小，释放时核对传回的大小是否与分配时一致
+struct deque_alloc_record {
+    static std::map<void*, size_t>& live() {
+        static std::map<void*, size_t> blocks;
+        return blocks;
+    }
+    static size_t& mismatches() {
+        static size_t count = 0;
+        return count;
+    }
+};
+
+template <typename T>
+class deque_counting_alloc {
+   public:
+    using value_type = T;
+    using size_type = size_t;
+
+    static T* allocate() { return allocate(1); }
+    static T* allocate(size_type n) {
+        T* ptr = static_cast<T*>(::operator new(n * sizeof(T)));
+        deque_alloc_record::live()[ptr] = n * sizeof(T);
+        return ptr;
+    }
+    static void deallocate(T* ptr) { deallocate(ptr, 1); }
+    static void deallocate(T* ptr, size_type n) {
+        std::map<void*, size_t>::iterator it =
+            deque_alloc_record::live().find(ptr);
+        if (it == deque_alloc_record::live().end() ||
+            it->second != n * sizeof(T))
+            ++deque_alloc_record::mismatches();
+        else
+            deque_alloc_record::live().erase(it);
+        ::operator delete(ptr);
+    }
+    template <typename U>
+    struct rebind {
+        using other = deque_counting_alloc<U>;
+    };
+};
+
+// 逐个比较 deque 与作为参照的 std::vector
+template <typename Deque, typename T>
+bool deque_equal(const Deque& d, const std::vector<T>& v) {
+    if (d.size() != v.size())
+        return false;
+    for (size_t i = 0; i != v.size(); ++i)
+        if (d[i] != v[i])
+            return false;
+    return true;
+}
+
+void deque_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[----------------- Run container test : deque "
+                 "------------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    int a[] = {1, 2, 3, 4, 5};
+    mystl::deque<int> d1;
+    mystl::deque<int> d2(10, 1);
+    mystl::deque<int> d3(a, a + 5);
+    mystl::deque<int> d4(d3);
+    PRINT(d1);
+    PRINT(d2);
+    PRINT(d3);
+    PRINT(d4);
+    FUN_AFTER(d1, d1.push_back(6));
+    FUN_AFTER(d1, d1.push_front(8));
+    FUN_AFTER(d1, d1.insert(d1.begin() + 1, 7));
+    FUN_AFTER(d1, d1.insert(d1.end(), 2, 3));
+    FUN_AFTER(d1, d1.pop_back());
+    FUN_AFTER(d1, d1.pop_front());
+    FUN_AFTER(d1, d1.erase(d1.begin()));
+    FUN_AFTER(d3, d3.erase(d3.begin() + 1, d3.begin() + 3));
+    FUN_AFTER(d1, d1.swap(d3));
+    FUN_VALUE(d1.front());
+    FUN_VALUE(d1.back());
+    FUN_VALUE(d1[1]);
+    FUN_VALUE(d1.size());
+    FUN_AFTER(d1, d1.clear());
+    FUN_VALUE(d1.empty());
+
+    // int 的缓冲区为 256 个元素，n 取几个缓冲区长，使迭代器反复跨越缓冲区边界
+    const int n = 2000;
+    mystl::deque<int> d5;
+    for (int i = 0; i != n; ++i)
+        d5.push_back(i);
+    bool step_ok = true;
+    int expect = 0;
+    for (mystl::deque<int>::iterator it = d5.begin(); it != d5.end(); ++it)
+        step_ok = step_ok && *it == expect++;
+    expect = 0;
+    for (mystl::deque<int>::iterator it = d5.begin(); it != d5.end();)
+        step_ok = step_ok && *it++ == expect++;
+    mystl::deque<int>::iterator back = d5.end();
+    for (int i = n - 1; i >= 0; --i)
+        step_ok = step_ok && *--back == i;
+    std::cout << " operator++ across buffers : " << step_ok << "\n";
+    bool jump_ok = true;
+    const int steps[] = {1, 255, 256, 257, 600, -1, -256, -300};
+    for (int i = 0; i < n; i += 37) {
+        for (int s : steps) {
+            if (i + s < 0 || i + s >= n)
+                continue;
+            mystl::deque<int>::iterator it = d5.begin() + i;
+            it += s;
+            jump_ok = jump_ok && *it == i + s && it - d5.begin() == i + s;
+            jump_ok = jump_ok && *((d5.begin() + i) + s) == i + s;
+        }
+    }
+    std::cout << " operator+= across buffers : " << jump_ok << "\n";
+
+    // 区间删除分别走移动前段和移动后段两条路径
+    std::vector<int> model;
+    for (int i = 0; i != n; ++i)
+        model.push_back(i);
+    d5.erase(d5.begin() + 100, d5.begin() + 700);
+    model.erase(model.begin() + 100, model.begin() + 700);
+    bool erase_ok = deque_equal(d5, model);
+    d5.erase(d5.end() - 900, d5.end() - 300);
+    model.erase(model.end() - 900, model.end() - 300);
+    erase_ok = erase_ok && deque_equal(d5, model);
+    d5.erase(d5.begin() + 1, d5.end() - 1);
+    model.erase(model.begin() + 1, model.end() - 1);
+    erase_ok = erase_ok && deque_equal(d5, model);
+    std::cout << " range erase : " << erase_ok << "\n";
+
+    // 缓冲区与中控器都经由 Alloc 分配，释放时传回的大小必须与分配时一致
+    {
+        mystl::deque<int, deque_counting_alloc<int>> d6;
+        for (int i = 0; i != n; ++i) {
+            d6.push_back(i);
+            d6.push_front(-i);
+        }
+        d6.erase(d6.begin() + 10, d6.begin() + 1500);
+        d6.erase(d6.end() - 1500, d6.end() - 10);
+        for (int i = 0; i != 300; ++i)
+            d6.pop_front();
+        d6.insert(d6.begin() + 5, 1000, 7);
+        mystl::deque<int, deque_counting_alloc<int>> d7(d6);
+        d7.clear();
+        FUN_VALUE(d6.size());
+    }
+    FUN_VALUE(deque_alloc_record::live().size());
+    FUN_VALUE(deque_alloc_record::mismatches());
+
+    mystl::deque<std::string> d8;
+    for (int i = 0; i != 600; ++i) {
+        d8.push_back(std::string(i % 20 + 1, 'a'));
+        d8.push_front(std::to_string(i));
+    }
+    d8.erase(d8.begin() + 10, d8.begin() + 400);
+    d8.insert(d8.begin() + 3, std::string("inserted"));
+    d8.pop_back();
+    mystl::deque<std::string> d9(d8);
+    FUN_VALUE(d9.size());
+    FUN_VALUE(d9[3]);
+    FUN_VALUE(d9.back());
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_DEQUE_H_
@@ -0,0 +1,177 @@
+#if !defined(MYSTL_TEST_FLAT_SET_H_)
+#define MYSTL_TEST_FLAT_SET_H_
+
+#include <stdlib.h>
+#include <time.h>
+#include <iostream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test.h"
+#include "../flat_map.h"
+#include "../flat_set.h"
+#include "../set.h"
+
+namespace mystl {
+
+void flat_set_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[--------------- Run container test : flat_set "
+                 "------------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    int a[] = {5, 3, 9, 1, 7, 3, 11};
+    mystl::flat_set<int> s1(a, a + 7);
+    PRINT(s1);
+    FUN_VALUE(s1.size());
+    FUN_VALUE(*s1.find(7));
+    FUN_VALUE((s1.find(4) == s1.end()));
+    FUN_VALUE(*s1.lower_bound(4));
+    FUN_VALUE(*s1.upper_bound(9));
+    FUN_VALUE((s1.equal_range(3).second - s1.equal_range(3).first));
+    FUN_VALUE(s1.count(3));
+    FUN_AFTER(s1, s1.insert(4));
+    FUN_AFTER(s1, s1.insert(s1.end(), 20));
+    int b[] = {2, 20, 8, 2, 0};
+    FUN_AFTER(s1, s1.insert(b, b + 5));
+    FUN_AFTER(s1, s1.erase(9));
+    FUN_AFTER(s1, s1.erase(s1.begin()));
+    FUN_AFTER(s1, s1.reserve(100));
+    FUN_VALUE(s1.capacity());
+
+    // 随机插入删除，与 std::set 对照
+    mystl::flat_set<int> s2;
+    std::set<int> s3;
+    srand(2020);
+    bool ok = true;
+    for (int i = 0; i != 20000 && ok; ++i) {
+        int value = rand() % 2000;
+        switch (rand() % 4) {
+            case 0:
+                ok = s2.erase(value) == s3.erase(value);
+                break;
+            case 1: {
+                std::vector<int> v;
+                for (int j = rand() % 20; j != 0; --j)
+                    v.push_back(rand() % 2000);
+                s2.insert(v.begin(), v.end());
+                s3.insert(v.begin(), v.end());
+                break;
+            }
+            default:
+                ok = s2.insert(value).second == s3.insert(value).second;
+        }
+    }
+    ok = ok && s2.size() == s3.size() &&
+         std::equal(s2.begin(), s2.end(), s3.begin());
+    std::cout << " flat_set consistent with std::set : " << ok << "\n";
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+}
+
+void flat_map_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[--------------- Run container test : flat_map "
+                 "------------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    std::pair<int, std::string> a[] = {
+        {3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}};
+    mystl::flat_map<int, std::string> m1(a, a + 4);
+    FUN_VALUE(m1.size());
+    FUN_VALUE(m1[1]);
+    FUN_VALUE(m1.at(3));
+    FUN_VALUE(m1.find(2)->second);
+    FUN_VALUE((m1.find(5) == m1.end()));
+    FUN_VALUE(m1.lower_bound(2)->first);
+    FUN_VALUE(m1.upper_bound(2)->first);
+    m1[5] = "five";
+    FUN_VALUE(m1.size());
+    FUN_VALUE(m1.insert(std::make_pair(5, std::string("cinq"))).second);
+    FUN_VALUE(m1[5]);
+    FUN_VALUE(m1.erase(2));
+    FUN_VALUE(m1.count(2));
+    try {
+        m1.at(2);
+        std::cout << " at(2) did not throw\n";
+    } catch (const std::out_of_range&) {
+        std::cout << " at(2) throws out_of_range\n";
+    }
+
+    // 随机操作，与 std::map 对照
+    mystl::flat_map<int, int> m2;
+    std::map<int, int> m3;
+    srand(2020);
+    bool ok = true;
+    for (int i = 0; i != 20000 && ok; ++i) {
+        int key = rand() % 2000;
+        switch (rand() % 4) {
+            case 0:
+                ok = m2.erase(key) == m3.erase(key);
+                break;
+            case 1: {
+                std::vector<std::pair<int, int>> v;
+                for (int j = rand() % 20; j != 0; --j)
+                    v.push_back(std::make_pair(rand() % 2000, i));
+                m2.insert(v.begin(), v.end());
+                m3.insert(v.begin(), v.end());
+                break;
+            }
+            default:
+                ok = ++m2[key] == ++m3[key];
+        }
+    }
+    ok = ok && m2.size() == m3.size() &&
+         std::equal(m2.begin(), m2.end(), m3.begin(),
+                    [](const std::pair<int, int>& x,
+                       const std::pair<const int, int>& y) {
+                        return x.first == y.first && x.second == y.second;
+                    });
+    std::cout << " flat_map consistent with std::map : " << ok << "\n";
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+}
+
+void flat_set_find_test() {
+    // 一次性构建后只做查找，比较 flat_set 与 set
+    const int count = 4000000;
+    std::vector<int> keys;
+    srand(2020);
+    for (int i = 0; i != count; ++i)
+        keys.push_back(rand());
+    clock_t start = clock();
+    mystl::set<int> s1(keys.begin(), keys.end());
+    clock_t end = clock();
+    std::cout << "Time to build set from " << count
+              << " numbers: " << end - start << std::endl;
+    start = clock();
+    mystl::flat_set<int> s2;
+    s2.reserve(count);
+    s2.insert(keys.begin(), keys.end());
+    end = clock();
+    std::cout << "Time to build flat_set from " << count
+              << " numbers: " << end - start << std::endl;
+
+    size_t found1 = 0, found2 = 0;
+    start = clock();
+    for (int i = 0; i != count; ++i)
+        found1 += s1.find(keys[size_t(i) * 7919 % count]) != s1.end();
+    end = clock();
+    std::cout << "Time to find " << count
+              << " numbers in set: " << end - start << std::endl;
+    start = clock();
+    for (int i = 0; i != count; ++i)
+        found2 += s2.find(keys[size_t(i) * 7919 % count]) != s2.end();
+    end = clock();
+    std::cout << "Time to find " << count
+              << " numbers in flat_set: " << end - start << std::endl;
+    std::cout << " result equal : " << (found1 == found2) << "\n";
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_FLAT_SET_H_
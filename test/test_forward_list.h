@@ -0,0 +1,65 @@
+#if !defined(MYSTL_TEST_FORWARD_LIST_H_)
+#define MYSTL_TEST_FORWARD_LIST_H_
+
+#include <iostream>
+#include <functional>
+#include <string>
+#include "test.h"
+#include "../forward_list.h"
+
+namespace mystl {
+
+void forward_list_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[-------------- Run container test : forward_list "
+                 "--------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    int a[] = {1, 2, 3, 4, 5};
+    mystl::forward_list<int> f1;
+    mystl::forward_list<int> f2(5);
+    mystl::forward_list<int> f3(5, 1);
+    mystl::forward_list<int> f4(a, a + 5);
+    mystl::forward_list<int> f5(f4);
+    mystl::forward_list<int> f6 = {9, 3, 7, 1, 8, 2};
+    f1 = f3;
+    PRINT(f1);
+    PRINT(f2);
+    PRINT(f3);
+    PRINT(f4);
+    PRINT(f5);
+    PRINT(f6);
+    FUN_AFTER(f1, f1.push_front(6));
+    FUN_AFTER(f1, f1.insert_after(f1.begin(), 7));
+    FUN_AFTER(f1, f1.insert_after(f1.before_begin(), 2, 3));
+    FUN_AFTER(f1, f1.pop_front());
+    FUN_AFTER(f1, f1.erase_after(f1.begin()));
+    FUN_AFTER(f1, f1.erase_after(f1.begin(), f1.end()));
+    FUN_AFTER(f1, f1.splice_after(f1.before_begin(), f2));
+    FUN_AFTER(f1, f1.splice_after(f1.begin(), f4, f4.begin()));
+    FUN_AFTER(f1, f1.splice_after(f1.before_begin(), f4, f4.begin(), f4.end()));
+    FUN_VALUE(f1.front());
+    FUN_VALUE(f1.size());
+    FUN_VALUE(f1.empty());
+    FUN_AFTER(f1, f1.remove(0));
+    FUN_AFTER(f1, f1.reverse());
+    FUN_AFTER(f1, f1.sort());
+    FUN_AFTER(f6, f6.sort());
+    FUN_AFTER(f1, f1.merge(f6));
+    FUN_VALUE(f6.empty());
+    FUN_AFTER(f1, f1.sort(std::greater<int>()));
+    FUN_AFTER(f1, f1.swap(f5));
+    FUN_AFTER(f1, f1.clear());
+    FUN_VALUE(f1.size());
+    mystl::forward_list<std::string> f7;
+    f7.push_front("world");
+    f7.push_front("hello");
+    FUN_VALUE(f7.size());
+    FUN_VALUE(f7.front());
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_FORWARD_LIST_H_
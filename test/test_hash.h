@@ -0,0 +1,141 @@
+#if !defined(MYSTL_TEST_HASH_H_)
+#define MYSTL_TEST_HASH_H_
+
+#include <stdlib.h>
+#include <time.h>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "test.h"
+#include "../hash_map.h"
+#include "../hash_set.h"
+
+namespace mystl {
+
+void hash_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[---------------- Run container test : hash_set "
+                 "-----------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    int a[] = {5, 3, 9, 1, 7, 3, 11};
+    mystl::hash_set<int> s1(a, a + 7);
+    FUN_VALUE(s1.size());
+    FUN_VALUE(s1.bucket_count());
+    FUN_VALUE(*s1.find(7));
+    FUN_VALUE((s1.find(4) == s1.end()));
+    FUN_VALUE(s1.insert(4).second);
+    FUN_VALUE(s1.insert(4).second);
+    FUN_VALUE(s1.erase(9));
+    FUN_AFTER(s1, s1.erase(s1.find(1)));
+    FUN_AFTER(s1, s1.resize(1000));
+    FUN_VALUE(s1.bucket_count());
+
+    mystl::hash_multiset<int> ms1(a, a + 7);
+    FUN_VALUE(ms1.count(3));
+    FUN_VALUE(*ms1.insert(3));
+    FUN_VALUE(ms1.count(3));
+    FUN_VALUE((ms1.equal_range(3).first == ms1.find(3)));
+    FUN_VALUE(ms1.erase(3));
+    FUN_VALUE(ms1.size());
+
+    mystl::hash_map<std::string, int> m1;
+    m1["one"] = 1;
+    m1["two"] = 2;
+    FUN_VALUE(m1["one"]);
+    FUN_VALUE(m1.insert(std::make_pair(std::string("two"), 3)).second);
+    FUN_VALUE(m1.find("two")->second);
+    FUN_VALUE(m1.count("three"));
+
+    // 重新散列前后元素地址不变
+    mystl::hash_map<int, int> m2(10);
+    int* p = &m2[42];
+    *p = 7;
+    size_t buckets = m2.bucket_count();
+    for (int i = 0; i != 10000; ++i)
+        m2[i + 100] = i;
+    std::cout << " address stable across rehash : "
+              << (p == &m2[42] && *p == 7 && m2.bucket_count() > buckets)
+              << "\n";
+
+    // 与 std::unordered_multiset、std::unordered_map 对照随机插入删除
+    mystl::hash_multiset<int> ms2;
+    std::unordered_multiset<int> ms3;
+    mystl::hash_map<int, int> m3;
+    std::unordered_map<int, int> m4;
+    srand(2020);
+    bool ok = true;
+    for (int i = 0; i != 100000 && ok; ++i) {
+        int value = rand() % 3000;
+        switch (rand() % 4) {
+            case 0:
+                ok = ms2.erase(value) == ms3.erase(value) &&
+                     m3.erase(value) == m4.erase(value);
+                break;
+            case 1: {
+                mystl::hash_multiset<int>::iterator it = ms2.find(value);
+                if (it != ms2.end()) {
+                    ms2.erase(it);
+                    ms3.erase(ms3.find(value));
+                }
+                break;
+            }
+            default:
+                ms2.insert(value);
+                ms3.insert(value);
+                ok = ++m3[value] == ++m4[value];
+        }
+        if (i % 1000 == 0) {
+            size_t n = 0;
+            for (mystl::hash_multiset<int>::iterator it = ms2.begin();
+                 it != ms2.end(); ++it, ++n)
+                ok = ok && ms2.count(*it) == ms3.count(*it);
+            ok = ok && n == ms3.size() && m3.size() == m4.size();
+        }
+    }
+    mystl::hash_multiset<int> ms4(ms2);
+    ok = ok && ms4.size() == ms3.size();
+    ms4.erase(ms4.begin(), ms4.end());
+    ok = ok && ms4.empty();
+    std::cout << " hash containers consistent with std : " << ok << "\n";
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+}
+
+void hash_churn_test() {
+    // 反复插入删除，比较复用节点的 hash_map 与 std::unordered_map
+    const int count = 1000000;
+    const int rounds = 10;
+    std::vector<int> keys;
+    srand(2020);
+    for (int i = 0; i != count; ++i)
+        keys.push_back(rand());
+    mystl::hash_map<int, std::string> m1;
+    std::unordered_map<int, std::string> m2;
+    clock_t start = clock();
+    for (int r = 0; r != rounds; ++r) {
+        for (int i = 0; i != count; ++i)
+            m1.insert(std::make_pair(keys[i], std::string("value")));
+        for (int i = 0; i != count; ++i)
+            m1.erase(keys[i]);
+    }
+    clock_t end = clock();
+    std::cout << "Time to insert and erase " << count << " keys " << rounds
+              << " times in hash_map: " << end - start << std::endl;
+    start = clock();
+    for (int r = 0; r != rounds; ++r) {
+        for (int i = 0; i != count; ++i)
+            m2.insert(std::make_pair(keys[i], std::string("value")));
+        for (int i = 0; i != count; ++i)
+            m2.erase(keys[i]);
+    }
+    end = clock();
+    std::cout << "Time to insert and erase " << count << " keys " << rounds
+              << " times in std::unordered_map: " << end - start << std::endl;
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_HASH_H_
@@ -0,0 +1,95 @@
+#if !defined(MYSTL_TEST_INTRUSIVE_LIST_H_)
+#define MYSTL_TEST_INTRUSIVE_LIST_H_
+
+#include <iostream>
+#include <string>
+#include "test.h"
+#include "../intrusive_list.h"
+
+namespace mystl {
+
+// 同一个对象通过两个 hook 同时挂在两个链表上
+struct intrusive_item {
+    int value;
+    mystl::list_hook all_hook;
+    mystl::list_hook odd_hook;
+
+    explicit intrusive_item(int v = 0) : value(v) {}
+};
+
+inline std::ostream& operator<<(std::ostream& os, const intrusive_item& x) {
+    return os << x.value;
+}
+
+// 模板实参来自 std 时，链表内部的调用须不受 ADL 干扰
+template <typename V>
+struct intrusive_box {
+    V value;
+    mystl::list_hook hook;
+
+    explicit intrusive_box(const V& v = V()) : value(v) {}
+};
+
+template <typename V>
+inline std::ostream& operator<<(std::ostream& os, const intrusive_box<V>& x) {
+    return os << x.value;
+}
+
+void intrusive_list_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[------------- Run container test : intrusive_list "
+                 "-------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    using all_list = mystl::intrusive_list<intrusive_item, &intrusive_item::all_hook>;
+    using odd_list = mystl::intrusive_list<intrusive_item, &intrusive_item::odd_hook>;
+    intrusive_item items[8];
+    all_list l1;
+    all_list l2;
+    odd_list l3;
+    for (int i = 0; i != 8; ++i) {
+        items[i].value = i;
+        l1.push_back(items[i]);
+        if (i % 2)
+            l3.push_front(items[i]);
+    }
+    PRINT(l1);
+    PRINT(l3);
+    FUN_VALUE(l1.size());
+    FUN_VALUE(l3.size());
+    FUN_AFTER(l1, l1.erase(items[3]));
+    FUN_VALUE(items[3].all_hook.is_linked());
+    FUN_VALUE(items[3].odd_hook.is_linked());
+    FUN_AFTER(l1, l1.pop_front());
+    FUN_AFTER(l1, l1.pop_back());
+    FUN_AFTER(l2, l2.splice(l2.begin(), l1, l1.iterator_to(items[4]), l1.end()));
+    FUN_AFTER(l2, l2.splice(l2.end(), l1, l1.begin()));
+    FUN_AFTER(l2, l2.splice(l2.begin(), l1));
+    FUN_AFTER(l2, l2.reverse());
+    FUN_AFTER(l1, l1.swap(l2));
+    FUN_VALUE(l1.size());
+    FUN_VALUE(l2.size());
+    FUN_VALUE(l1.front());
+    FUN_VALUE(l1.back());
+    FUN_AFTER(l1, l1.clear());
+    PRINT(l3);
+
+    using box = intrusive_box<std::string>;
+    using box_list = mystl::intrusive_list<box, &box::hook>;
+    box boxes[] = {box("a"), box("b"), box("c"), box("d")};
+    box_list l4;
+    box_list l5;
+    for (box& b : boxes)
+        l4.push_back(b);
+    box_list::const_iterator first = l4.iterator_to(boxes[1]);
+    FUN_VALUE(first->value);
+    FUN_AFTER(l5, l5.splice(l5.end(), l4, l4.iterator_to(boxes[1]), l4.end()));
+    FUN_VALUE(l4.size());
+    FUN_VALUE(l5.size());
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_INTRUSIVE_LIST_H_
@@ -1,4 +1,6 @@
+#include <functional>
 #include <iostream>
+#include <string>
 #include "test.h"
 #include "../list.h"
 
@@ -53,10 +55,28 @@ void list_test() {
     FUN_VALUE(l1.empty());
     FUN_AFTER(l1, l1.reverse());
     FUN_AFTER(l1, l1.sort());
+    FUN_AFTER(l1, l1.sort(std::greater<int>()));
+    FUN_AFTER(l1, l1.unique());
+    FUN_AFTER(l1, l1.unique([](int a, int b) { return a - b == 1; }));
+    FUN_AFTER(l1, l1.remove_if([](int x) { return x > 4; }));
+    FUN_AFTER(l6, l6.sort(std::greater<int>()));
+    FUN_AFTER(l1, l1.merge(l6, std::greater<int>()));
+    FUN_AFTER(l1, l1.remove(0));
     FUN_VALUE(l1.size());
     FUN_AFTER(l1, l1.resize(30, 5));
+    FUN_AFTER(l7, l7.insert(l7.begin(), l5.extract(--l5.end())));
     FUN_AFTER(l1, l1.clear());
     FUN_VALUE(l1.size());
+
+    // 元素类型位于 std 中时，内部调用须不受 ADL 干扰
+    mystl::list<std::string> l8 = {"a", "b", "c", "d"};
+    mystl::list<std::string> l9 = {"x", "y", "z"};
+    FUN_AFTER(l8, l8.splice(l8.begin(), l9, ++l9.begin(), l9.end()));
+    FUN_AFTER(l8, l8.splice(l8.end(), l9, l9.begin()));
+    FUN_AFTER(l8, l8.splice(++l8.begin(), l8, --l8.end(), l8.end()));
+    FUN_AFTER(l8, l8.sort());
+    FUN_VALUE(l8.size());
+    FUN_VALUE(l9.size());
     std::cout << "[----------------------- end API test "
                  "---------------------------]\n";
 }
@@ -0,0 +1,100 @@
+#if !defined(MYSTL_TEST_LIST_INDEX_H_)
+#define MYSTL_TEST_LIST_INDEX_H_
+
+#include <time.h>
+#include <iostream>
+#include <string>
+#include "test.h"
+#include "../list.h"
+
+namespace mystl {
+
+void list_index_test() {
+    std::cout << "[----------------- Run container test : list index "
+                 "-------------]\n";
+    mystl::list<int> l1 = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    mystl::list<int> l2 = {10, 20, 30};
+    FUN_AFTER(l1, l1.enable_index());
+    FUN_VALUE(l1.index_enabled());
+    FUN_VALUE(l1[4]);
+    FUN_VALUE(l1.position(l1.end()));
+    FUN_VALUE(*l1.advance(l1.begin(), 6));
+    FUN_VALUE(*l1.advance(--l1.end(), -2));
+    FUN_AFTER(l1, l1.splice(l1.advance(l1.begin(), 3), l2));
+    FUN_VALUE(l1[3]);
+    FUN_VALUE(l1.position(l1.advance(l1.begin(), 5)));
+    FUN_AFTER(l1, l1.erase(l1.advance(l1.begin(), 2)));
+    FUN_VALUE(l1[2]);
+    FUN_AFTER(l1, l1.sort());
+    FUN_VALUE(l1[l1.size() - 1]);
+    FUN_AFTER(l1, l1.splice(l1.begin(), l1, l1.advance(l1.begin(), 8),
+                            l1.end()));
+    FUN_VALUE(l1[2]);
+    FUN_AFTER(l1, l1.disable_index());
+    FUN_VALUE(l1[3]);
+    mystl::list<std::string> l4 = {"a", "b", "c", "d"};
+    FUN_VALUE(l4.position(--l4.end()));
+    FUN_AFTER(l4, l4.enable_index());
+    FUN_AFTER(l4, l4.insert(l4.advance(l4.begin(), 2), "x"));
+    FUN_VALUE(l4.position(l4.advance(l4.begin(), 3)));
+
+    // 在循环中按下标访问，未开启索引时为 O(n^2)
+    const size_t count = 20000;
+    mystl::list<int> l3;
+    for (size_t i = 0; i != count; ++i)
+        l3.push_back(int(i));
+    long long sum1 = 0, sum2 = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i != count; ++i)
+        sum1 += l3[i];
+    clock_t end = clock();
+    std::cout << "Time to index " << count
+              << " elements of list by walking: " << end - start << std::endl;
+    l3.enable_index();
+    start = clock();
+    for (size_t i = 0; i != count; ++i)
+        sum2 += l3[i];
+    end = clock();
+    std::cout << "Time to index " << count
+              << " elements of list in index mode: " << end - start
+              << std::endl;
+    std::cout << " result equal : " << (sum1 == sum2) << "\n";
+
+    // 插入删除与按下标访问交替进行，索引随之更新而不是整体重建
+    mystl::list<int> l5;
+    mystl::list<int> l6;
+    for (size_t i = 0; i != count; ++i) {
+        l5.push_back(int(i));
+        l6.push_back(int(i));
+    }
+    l6.enable_index();
+    sum1 = sum2 = 0;
+    start = clock();
+    for (size_t i = 0; i != count; ++i) {
+        size_t k = i * 7919 % count;
+        l5.insert(l5.begin() + ptrdiff_t(k), int(i));
+        l5.erase(l5.begin() + ptrdiff_t(count - 1 - k));
+        sum1 += l5[k / 2];
+    }
+    end = clock();
+    std::cout << "Time to mix insert, erase and index " << count
+              << " times on list by walking: " << end - start << std::endl;
+    start = clock();
+    for (size_t i = 0; i != count; ++i) {
+        size_t k = i * 7919 % count;
+        l6.insert(l6.advance(l6.begin(), ptrdiff_t(k)), int(i));
+        l6.erase(l6.advance(l6.begin(), ptrdiff_t(count - 1 - k)));
+        sum2 += l6[k / 2];
+    }
+    end = clock();
+    std::cout << "Time to mix insert, erase and index " << count
+              << " times on list in index mode: " << end - start << std::endl;
+    bool same = l5.size() == l6.size();
+    for (auto i5 = l5.begin(), i6 = l6.begin(); same && i5 != l5.end();
+         ++i5, ++i6)
+        same = *i5 == *i6;
+    std::cout << " result equal : " << (sum1 == sum2 && same) << "\n";
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_LIST_INDEX_H_
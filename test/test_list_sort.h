@@ -0,0 +1,67 @@
+#if !defined(MYSTL_TEST_LIST_SORT_H_)
+#define MYSTL_TEST_LIST_SORT_H_
+
+#include <stdlib.h>
+#include <time.h>
+#include <iostream>
+#include <list>
+#include "../list.h"
+
+namespace mystl {
+
+// 按 key 比较，用于检查排序的稳定性
+struct list_sort_item {
+    int key;
+    int order;
+};
+
+struct list_sort_key_less {
+    bool operator()(const list_sort_item& lhs, const list_sort_item& rhs) const {
+        return lhs.key < rhs.key;
+    }
+};
+
+void list_sort_test() {
+    // std::list::sort 即为原先 list.h 中 64 个桶的链表归并排序
+    const size_t count = 1000000;
+    std::list<int> list1;
+    mystl::list<int> list2;
+    srand(2020);
+    for (size_t i = 0; i != count; ++i) {
+        int value = rand();
+        list1.push_back(value);
+        list2.push_back(value);
+    }
+    clock_t start = clock();
+    list1.sort();
+    clock_t end = clock();
+    std::cout << "Time to sort " << count
+              << " numbers in list with bucket merge sort: " << end - start
+              << std::endl;
+    start = clock();
+    list2.sort();
+    end = clock();
+    std::cout << "Time to sort " << count
+              << " numbers in list with pointer array merge sort: "
+              << end - start << std::endl;
+
+    bool same = true;
+    auto it = list1.begin();
+    for (auto x : list2)
+        same = same && (x == *it++);
+    std::cout << " result equal : " << same << "\n";
+
+    mystl::list<list_sort_item> list3;
+    for (int i = 0; i != 1000; ++i)
+        list3.push_back(list_sort_item{rand() % 10, i});
+    list3.sort(list_sort_key_less());
+    bool stable = true;
+    for (auto first = list3.begin(), next = ++list3.begin();
+         next != list3.end(); ++first, ++next)
+        if (first->key == next->key && first->order > next->order)
+            stable = false;
+    std::cout << " sort with comparator is stable : " << stable << "\n";
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_LIST_SORT_H_
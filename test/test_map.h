@@ -0,0 +1,107 @@
+#if !defined(MYSTL_TEST_MAP_H_)
+#define MYSTL_TEST_MAP_H_
+
+#include <stdlib.h>
+#include <iostream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "test.h"
+#include "../map.h"
+#include "../set.h"
+
+namespace mystl {
+
+void map_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[----------------- Run container test : map "
+                 "--------------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    std::pair<int, std::string> a[] = {
+        {3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}};
+    mystl::map<int, std::string> m1(a, a + 4);
+    FUN_VALUE(m1.size());
+    FUN_VALUE(m1[1]);
+    FUN_VALUE(m1.at(3));
+    FUN_VALUE(m1[4].empty());
+    FUN_VALUE(m1.size());
+    FUN_VALUE(m1.try_emplace(5, 3, 'x').second);
+    FUN_VALUE(m1[5]);
+    FUN_VALUE(m1.try_emplace(5, "five").second);
+    FUN_VALUE(m1[5]);
+    FUN_VALUE(m1.insert_or_assign(5, "five").second);
+    FUN_VALUE(m1[5]);
+    FUN_VALUE(m1.insert_or_assign(6, "six").second);
+    FUN_VALUE(m1.insert(m1.end(), std::make_pair(7, "seven"))->second);
+    FUN_VALUE(m1.lower_bound(4)->first);
+    FUN_VALUE(m1.upper_bound(4)->first);
+    FUN_VALUE(m1.erase(4));
+    FUN_VALUE(m1.count(4));
+    try {
+        m1.at(4);
+        std::cout << " at(4) did not throw\n";
+    } catch (const std::out_of_range&) {
+        std::cout << " at(4) throws out_of_range\n";
+    }
+
+    std::pair<int, int> b[] = {{2, 0}, {1, 1}, {2, 2}, {1, 3}, {2, 4}};
+    mystl::multimap<int, int> mm1(b, b + 5);
+    FUN_VALUE(mm1.size());
+    FUN_VALUE(mm1.count(2));
+    FUN_VALUE(mm1.insert(mm1.end(), std::make_pair(2, 5))->second);
+    FUN_VALUE(mm1.count(2));
+    FUN_VALUE((--mm1.end())->second);
+    FUN_VALUE(mm1.erase(1));
+    FUN_VALUE(mm1.size());
+
+    int c[] = {5, 3, 9, 3, 7, 3, 11};
+    mystl::multiset<int> ms1(c, c + 7);
+    PRINT(ms1);
+    FUN_VALUE(ms1.count(3));
+    FUN_AFTER(ms1, ms1.insert(9));
+    FUN_AFTER(ms1, ms1.insert(ms1.begin(), 1));
+    FUN_AFTER(ms1, ms1.erase(3));
+
+    // 随机操作，与 std::map、std::multimap 对照
+    mystl::map<int, int> m2;
+    std::map<int, int> m3;
+    mystl::multimap<int, int> mm2;
+    std::multimap<int, int> mm3;
+    srand(2020);
+    bool ok = true;
+    for (int i = 0; i != 100000 && ok; ++i) {
+        int key = rand() % 2000;
+        switch (rand() % 5) {
+            case 0:
+                ok = m2.erase(key) == m3.erase(key) &&
+                     mm2.erase(key) == mm3.erase(key);
+                break;
+            case 1:
+                ok = m2.insert_or_assign(key, i).second ==
+                     (m3.find(key) == m3.end());
+                m3[key] = i;
+                break;
+            case 2:
+                ok = m2.try_emplace(key, i).second ==
+                     m3.insert(std::make_pair(key, i)).second;
+                break;
+            default:
+                ok = ++m2[key] == ++m3[key];
+                mm2.insert(std::make_pair(key, i));
+                mm3.insert(std::make_pair(key, i));
+        }
+    }
+    ok = ok && m2.size() == m3.size() && mm2.size() == mm3.size() &&
+         std::equal(m2.begin(), m2.end(), m3.begin()) &&
+         std::equal(mm2.begin(), mm2.end(), mm3.begin());
+    std::cout << " map and multimap consistent with std : " << ok << "\n";
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_MAP_H_
@@ -0,0 +1,82 @@
+#if !defined(MYSTL_TEST_MPMC_QUEUE_H_)
+#define MYSTL_TEST_MPMC_QUEUE_H_
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "test.h"
+#include "../mpmc_queue.h"
+
+namespace mystl {
+
+// 分别用 threads 个生产者和 threads 个消费者传递 count 个数，返回耗时(ms)
+inline long long mpmc_throughput(size_t threads, size_t count) {
+    mystl::mpmc_queue<size_t> q(1024);
+    std::atomic<size_t> sum(0);
+    size_t per_thread = count / threads;
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t != threads; ++t) {
+        workers.emplace_back([&q, per_thread] {
+            for (size_t i = 0; i != per_thread; ++i)
+                q.push(i);
+        });
+        workers.emplace_back([&q, &sum, per_thread] {
+            size_t value, local = 0;
+            for (size_t i = 0; i != per_thread; ++i) {
+                q.pop(value);
+                local += value;
+            }
+            sum += local;
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    auto end = std::chrono::steady_clock::now();
+    if (sum != threads * (per_thread * (per_thread - 1) / 2))
+        std::cout << " checksum mismatch!\n";
+    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+        .count();
+}
+
+void mpmc_queue_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[-------------- Run container test : mpmc_queue "
+                 "----------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    int x = 0;
+    mystl::mpmc_queue<int> q1(3);
+    FUN_VALUE(q1.capacity());
+    FUN_VALUE(q1.empty());
+    FUN_VALUE(q1.try_push(1));
+    FUN_VALUE(q1.try_push(2));
+    FUN_VALUE(q1.try_push(3));
+    FUN_VALUE(q1.try_push(4));
+    FUN_VALUE(q1.try_push(5));
+    FUN_VALUE(q1.size());
+    FUN_VALUE(q1.try_pop(x));
+    FUN_VALUE(x);
+    q1.pop(x);
+    FUN_VALUE(x);
+    q1.push(6);
+    FUN_VALUE(q1.size());
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+
+    const size_t count = 1000000;
+    size_t max_threads = std::thread::hardware_concurrency();
+    if (max_threads < 4)
+        max_threads = 4;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+        std::cout << "Time to pass " << count << " numbers through mpmc_queue"
+                  << " with " << threads << " producers and " << threads
+                  << " consumers: " << mpmc_throughput(threads, count)
+                  << " ms" << std::endl;
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_MPMC_QUEUE_H_
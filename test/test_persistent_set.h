@@ -0,0 +1,108 @@
+#if !defined(MYSTL_TEST_PERSISTENT_SET_H_)
+#define MYSTL_TEST_PERSISTENT_SET_H_
+
+#include <stdlib.h>
+#include <time.h>
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <vector>
+#include "test.h"
+#include "../persistent_set.h"
+#include "../set.h"
+
+namespace mystl {
+
+void persistent_set_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[------------ Run container test : persistent_set "
+                 "--------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    int a[] = {5, 3, 9, 1, 7, 3, 11};
+    mystl::persistent_set<int> s1(a, a + 7);
+    PRINT(s1);
+    FUN_VALUE(s1.size());
+    mystl::persistent_set<int> s2 = s1.snapshot();
+    FUN_AFTER(s1, s1.erase(5));
+    FUN_AFTER(s1, s1.insert(4));
+    FUN_VALUE(s1.insert(4).second);
+    PRINT(s2);
+    FUN_VALUE(s2.size());
+    FUN_VALUE(*s2.find(5));
+    FUN_VALUE((s1.find(5) == s1.end()));
+    FUN_VALUE(*s1.lower_bound(5));
+    FUN_VALUE(*s2.upper_bound(5));
+    FUN_VALUE(s2.count(4));
+
+    // 随机插入删除并不断留下快照，最后检查每个快照仍与当时的 std::set 相同
+    mystl::persistent_set<int> s3;
+    std::set<int> s4;
+    std::vector<mystl::persistent_set<int>> snaps;
+    std::vector<std::set<int>> expect;
+    srand(2020);
+    bool ok = true;
+    for (int i = 0; i != 100000 && ok; ++i) {
+        int value = rand() % 3000;
+        if (rand() % 3 == 0)
+            ok = s3.erase(value) == s4.erase(value);
+        else
+            ok = s3.insert(value).second == s4.insert(value).second;
+        if (i % 5000 == 0) {
+            ok = ok && s3.rb_verify() && s3.size() == s4.size() &&
+                 std::equal(s4.begin(), s4.end(), s3.begin());
+            snaps.push_back(s3.snapshot());
+            expect.push_back(s4);
+        }
+    }
+    for (size_t i = 0; i != snaps.size(); ++i)
+        ok = ok && snaps[i].rb_verify() && snaps[i].size() == expect[i].size() &&
+             std::equal(expect[i].begin(), expect[i].end(), snaps[i].begin());
+    s3.clear();
+    ok = ok && s3.empty() && snaps.back().size() == expect.back().size();
+    std::cout << " snapshots unchanged by later updates : " << ok << "\n";
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+}
+
+void persistent_set_snapshot_test() {
+    // 每次更新前取一次快照：set 需要整树复制，persistent_set 只复制路径
+    const int count = 1000000;
+    const int rounds = 100;
+    std::vector<int> keys;
+    srand(2020);
+    for (int i = 0; i != count; ++i)
+        keys.push_back(rand());
+    mystl::set<int> s1(keys.begin(), keys.end());
+    mystl::persistent_set<int> s2(keys.begin(), keys.end());
+    size_t total1 = 0, total2 = 0;
+    clock_t start = clock();
+    for (int r = 0; r != rounds; ++r) {
+        mystl::set<int> snap(s1);
+        s1.insert(keys[r] + 1);
+        s1.erase(keys[r]);
+        total1 += snap.size();
+    }
+    clock_t end = clock();
+    std::cout << "Time to snapshot and update a set of " << count << " numbers "
+              << rounds << " times: " << end - start << std::endl;
+    start = clock();
+    for (int r = 0; r != rounds; ++r) {
+        mystl::persistent_set<int> snap = s2.snapshot();
+        s2.insert(keys[r] + 1);
+        s2.erase(keys[r]);
+        total2 += snap.size();
+    }
+    end = clock();
+    std::cout << "Time to snapshot and update a persistent_set of " << count
+              << " numbers " << rounds << " times: " << end - start
+              << std::endl;
+    std::cout << " result equal : "
+              << (total1 == total2 && s1.size() == s2.size() &&
+                  std::equal(s1.begin(), s1.end(), s2.begin()))
+              << "\n";
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_PERSISTENT_SET_H_
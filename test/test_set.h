@@ -0,0 +1,238 @@
+#if !defined(MYSTL_TEST_SET_H_)
+#define MYSTL_TEST_SET_H_
+
+#include <stdlib.h>
+#include <time.h>
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <vector>
+#include "test.h"
+#include "../set.h"
+
+namespace mystl {
+
+void set_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[----------------- Run container test : set "
+                 "--------------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    int a[] = {5, 3, 9, 1, 7, 3, 11};
+    mystl::ranked_set<int> s1(a, a + 7);
+    PRINT(s1);
+    FUN_VALUE(s1.size());
+    FUN_VALUE(sizeof(mystl::tree_node<int>));
+    FUN_VALUE(sizeof(mystl::tree_rank_node<int>));
+    FUN_VALUE(*s1.select(0));
+    FUN_VALUE(*s1.select(3));
+    FUN_VALUE((s1.select(6) == s1.end()));
+    FUN_VALUE(s1.rank(1));
+    FUN_VALUE(s1.rank(7));
+    FUN_VALUE(s1.rank(8));
+    FUN_VALUE(s1.rank(100));
+    FUN_AFTER(s1, s1.erase(5));
+    FUN_VALUE(*s1.select(2));
+    FUN_VALUE(s1.rank(9));
+    FUN_AFTER(s1, s1.insert(4));
+    FUN_VALUE(*s1.select(2));
+
+    // 随机插入删除后逐个核对 select 与 rank
+    mystl::ranked_set<int> s2;
+    srand(2020);
+    for (int i = 0; i != 20000; ++i) {
+        if (rand() % 3)
+            s2.insert(rand() % 10000);
+        else
+            s2.erase(rand() % 10000);
+    }
+    bool ok = true;
+    size_t k = 0;
+    for (auto it = s2.begin(); it != s2.end(); ++it, ++k)
+        ok = ok && s2.select(k) == it && s2.rank(*it) == k;
+    std::cout << " select and rank consistent : " << ok << "\n";
+    // 拆分后两棵树的子树大小仍然正确
+    mystl::ranked_set<int> s3;
+    size_t n = s2.size();
+    s2.split(5000, s3);
+    k = 0;
+    ok = s2.size() + s3.size() == n && s2.rank(5000) == s2.size();
+    for (auto it = s3.begin(); it != s3.end(); ++it, ++k)
+        ok = ok && s3.select(k) == it && s3.rank(*it) == k;
+    std::cout << " select and rank after split : " << ok << "\n";
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+}
+
+void set_sorted_build_test() {
+    // 有序输入走线性建树，打乱一个元素后退化为逐个插入
+    const int count = 1000000;
+    std::vector<int> sorted;
+    for (int i = 0; i != count; ++i)
+        sorted.push_back(i / 2 * 3);
+    std::vector<int> unsorted(sorted);
+    std::swap(unsorted[count / 2], unsorted[count - 1]);
+    clock_t start = clock();
+    mystl::set<int> s1(sorted.begin(), sorted.end());
+    clock_t end = clock();
+    std::cout << "Time to build set from " << count
+              << " sorted numbers: " << end - start << std::endl;
+    start = clock();
+    mystl::set<int> s2(unsorted.begin(), unsorted.end());
+    end = clock();
+    std::cout << "Time to build set from " << count
+              << " nearly sorted numbers: " << end - start << std::endl;
+    bool same = s1.size() == s2.size();
+    for (auto it1 = s1.begin(), it2 = s2.begin(); same && it1 != s1.end();
+         ++it1, ++it2)
+        same = *it1 == *it2;
+    std::cout << " result equal : " << same << "\n";
+}
+void set_node_handle_test() {
+    int a[] = {1, 3, 5, 7, 9};
+    mystl::set<int> s1(a, a + 5), s2;
+    auto nh = s1.extract(5);
+    FUN_VALUE(nh.value());
+    PRINT(s1);
+    FUN_AFTER(s2, s2.insert(std::move(nh)));
+    FUN_VALUE(nh.empty());
+    nh = s1.extract(s1.begin());
+    nh.value() = 8;
+    FUN_AFTER(s1, s1.insert(std::move(nh)));
+    nh = s1.extract(8);
+    s2.insert(8);
+    FUN_VALUE(s2.insert(std::move(nh)).second);
+    FUN_VALUE(nh.empty());
+    FUN_VALUE(s1.extract(100).empty());
+}
+
+void set_join_test() {
+    int a[] = {1, 3, 5, 7, 9};
+    int b[] = {2, 3, 4, 9, 10};
+    mystl::set<int> s1(a, a + 5), s2(b, b + 5), s3;
+    FUN_AFTER(s1, s1.split(5, s3));
+    PRINT(s3);
+    FUN_AFTER(s1, s1.join(s3));
+    FUN_VALUE(s3.size());
+    s3.insert(b, b + 5);
+    FUN_AFTER(s1, s1.unite(s3));
+    s3.insert(b, b + 5);
+    FUN_AFTER(s1, s1.subtract(s3));
+    s3.insert(a, a + 5);
+    FUN_AFTER(s1, s1.intersect(s3));
+    FUN_AFTER(s2, s2.unite(s1));
+
+    // 合并两个大集合，与逐个插入比较
+    const int count = 1000000;
+    std::vector<int> v1, v2;
+    srand(2020);
+    for (int i = 0; i != count; ++i) {
+        v1.push_back(rand());
+        v2.push_back(rand());
+    }
+    mystl::set<int> big1(v1.begin(), v1.end()), big2(v2.begin(), v2.end());
+    mystl::set<int> big3(v1.begin(), v1.end()), big4(v2.begin(), v2.end());
+    clock_t start = clock();
+    for (auto it = big4.begin(); it != big4.end(); ++it)
+        big3.insert(*it);
+    clock_t end = clock();
+    std::cout << "Time to merge two sets of " << count
+              << " numbers by insert: " << end - start << std::endl;
+    start = clock();
+    big1.unite(big2);
+    end = clock();
+    std::cout << "Time to merge two sets of " << count
+              << " numbers by unite: " << end - start << std::endl;
+    bool same = big1.size() == big3.size();
+    for (auto it1 = big1.begin(), it3 = big3.begin(); same && it1 != big1.end();
+         ++it1, ++it3)
+        same = *it1 == *it3;
+    std::cout << " result equal : " << same << "\n";
+
+    // 小集合并入大集合时只需 O(m log(n/m + 1))
+    mystl::set<int> small(v1.begin(), v1.begin() + 100);
+    start = clock();
+    big1.unite(small);
+    end = clock();
+    std::cout << "Time to merge 100 numbers into a set of " << big1.size()
+              << " numbers by unite: " << end - start << std::endl;
+}
+void set_insert_order_test() {
+    // 逐个插入升序、降序与随机的键，升降序走端点快速路径
+    const int count = 2000000;
+    std::vector<int> keys;
+    for (int i = 0; i != count; ++i)
+        keys.push_back(i);
+    const char* names[] = {"increasing", "decreasing", "random"};
+    for (int order = 0; order != 3; ++order) {
+        if (order == 1)
+            std::reverse(keys.begin(), keys.end());
+        if (order == 2) {
+            srand(2020);
+            for (int i = count - 1; i > 0; --i)
+                std::swap(keys[i], keys[rand() % (i + 1)]);
+        }
+        mystl::set<int> s1;
+        clock_t start = clock();
+        for (int i = 0; i != count; ++i)
+            s1.insert(keys[i]);
+        clock_t end = clock();
+        std::cout << "Time to insert " << count << " " << names[order]
+                  << " numbers into set: " << end - start << std::endl;
+        // 带子树大小时每次插入都要更新到根的整条路径
+        mystl::ranked_set<int> s3;
+        start = clock();
+        for (int i = 0; i != count; ++i)
+            s3.insert(keys[i]);
+        end = clock();
+        std::cout << "Time to insert " << count << " " << names[order]
+                  << " numbers into ranked_set: " << end - start << std::endl;
+        mystl::set<int> s2(s1);
+        start = clock();
+        s2.insert(keys.begin(), keys.end());
+        end = clock();
+        std::cout << "Time to insert " << count << " " << names[order]
+                  << " duplicate numbers into set: " << end - start
+                  << std::endl;
+        std::cout << " size : " << s1.size() << " " << s2.size() << " "
+                  << s3.size() << "\n";
+    }
+}
+void set_iterate_test() {
+    // 随机插入建成的大树，节点在内存中的顺序与中序无关，遍历受访存延迟限制
+    const int count = 4000000;
+    mystl::set<int> s1;
+    std::set<int> s2;
+    srand(2020);
+    for (int i = 0; i != count; ++i) {
+        int value = rand();
+        s1.insert(value);
+        s2.insert(value);
+    }
+    long long sum1 = 0, sum2 = 0, sum3 = 0;
+    clock_t start = clock();
+    for (int x : s1)
+        sum1 += x;
+    clock_t end = clock();
+    std::cout << "Time to iterate over set of " << s1.size()
+              << " numbers: " << end - start << std::endl;
+    start = clock();
+    for (mystl::set<int>::iterator it = s1.end(); it != s1.begin();)
+        sum2 += *--it;
+    end = clock();
+    std::cout << "Time to iterate backward over set of " << s1.size()
+              << " numbers: " << end - start << std::endl;
+    start = clock();
+    for (int x : s2)
+        sum3 += x;
+    end = clock();
+    std::cout << "Time to iterate over std::set of " << s2.size()
+              << " numbers: " << end - start << std::endl;
+    std::cout << " result equal : " << (sum1 == sum2 && sum1 == sum3)
+              << "\n";
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_SET_H_
@@ -0,0 +1,76 @@
+#if !defined(MYSTL_TEST_SPSC_QUEUE_H_)
+#define MYSTL_TEST_SPSC_QUEUE_H_
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include "test.h"
+#include "../spsc_queue.h"
+
+namespace mystl {
+
+void spsc_queue_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[-------------- Run container test : spsc_queue "
+                 "----------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    int a[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    int b[9];
+    int x = 0;
+    mystl::spsc_queue<int> q1(6);
+    FUN_VALUE(q1.capacity());
+    FUN_VALUE(q1.empty());
+    FUN_VALUE(q1.try_push(a, 9));
+    FUN_VALUE(q1.full());
+    FUN_VALUE(q1.try_push(10));
+    FUN_VALUE(q1.try_pop(x));
+    FUN_VALUE(x);
+    FUN_VALUE(*q1.front());
+    FUN_VALUE(q1.try_pop(b, 9));
+    FUN_VALUE(b[6]);
+    FUN_VALUE(q1.size());
+    FUN_VALUE(q1.try_pop(x));
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+
+    // 一个线程写、一个线程读，每次批量传递 64 个元素，统计吞吐量
+    const size_t count = 10000000;
+    const size_t batch = 64;
+    mystl::spsc_queue<size_t> q2(1024);
+    size_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumer([&] {
+        size_t buf[batch];
+        for (size_t i = 0; i != count;) {
+            size_t n = q2.try_pop(buf, batch);
+            if (n == 0)
+                std::this_thread::yield();
+            for (size_t j = 0; j != n; ++j)
+                sum += buf[j];
+            i += n;
+        }
+    });
+    size_t buf[batch];
+    for (size_t i = 0; i != count;) {
+        size_t n = count - i < batch ? count - i : batch;
+        for (size_t j = 0; j != n; ++j)
+            buf[j] = i + j;
+        n = q2.try_push(buf, n);
+        if (n == 0)
+            std::this_thread::yield();
+        i += n;
+    }
+    consumer.join();
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "Time to pass " << count
+              << " numbers through spsc_queue: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(
+                     end - start).count()
+              << " ms, checksum " << (sum == count * (count - 1) / 2)
+              << std::endl;
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_SPSC_QUEUE_H_
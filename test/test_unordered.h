@@ -0,0 +1,150 @@
+#if !defined(MYSTL_TEST_UNORDERED_H_)
+#define MYSTL_TEST_UNORDERED_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "test.h"
+#include "../set.h"
+#include "../unordered_map.h"
+#include "../unordered_set.h"
+
+namespace mystl {
+
+// 可以直接用 const char* 查找 std::string 键，不必构造临时字符串
+struct string_hash {
+    using is_transparent = void;
+    size_t operator()(const std::string& s) const {
+        return std::hash<std::string>()(s);
+    }
+    size_t operator()(const char* s) const {
+        return std::_Hash_impl::hash(s, strlen(s));
+    }
+};
+
+struct string_equal {
+    using is_transparent = void;
+    bool operator()(const std::string& lhs, const std::string& rhs) const {
+        return lhs == rhs;
+    }
+    bool operator()(const std::string& lhs, const char* rhs) const {
+        return lhs == rhs;
+    }
+};
+
+void unordered_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[------------- Run container test : unordered_set "
+                 "--------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    int a[] = {5, 3, 9, 1, 7, 3, 11};
+    mystl::unordered_set<int> s1(a, a + 7);
+    FUN_VALUE(s1.size());
+    FUN_VALUE(s1.bucket_count());
+    FUN_VALUE(*s1.find(7));
+    FUN_VALUE((s1.find(4) == s1.end()));
+    FUN_VALUE(s1.count(3));
+    FUN_VALUE(s1.insert(4).second);
+    FUN_VALUE(s1.insert(4).second);
+    FUN_VALUE(s1.erase(9));
+    FUN_VALUE(s1.erase(9));
+    FUN_VALUE(s1.size());
+    s1.reserve(1000);
+    FUN_VALUE(s1.bucket_count());
+    FUN_VALUE(s1.count(11));
+
+    mystl::unordered_map<std::string, int, string_hash, string_equal> m1;
+    m1["one"] = 1;
+    m1["two"] = 2;
+    FUN_VALUE(m1.try_emplace("three", 3).second);
+    FUN_VALUE(m1.try_emplace("three", 4).second);
+    FUN_VALUE(m1.insert_or_assign("three", 5).second);
+    FUN_VALUE(m1.at("three"));
+    FUN_VALUE(m1.find("two")->second);
+    FUN_VALUE(m1.count("four"));
+    FUN_VALUE(m1.size());
+
+    // 与 std 的无序容器对照随机插入删除
+    mystl::unordered_set<int> s2;
+    std::unordered_set<int> s3;
+    mystl::unordered_map<int, int> m2;
+    std::unordered_map<int, int> m3;
+    srand(2020);
+    bool ok = true;
+    for (int i = 0; i != 200000 && ok; ++i) {
+        int value = rand() % 5000;
+        switch (rand() % 3) {
+            case 0:
+                ok = s2.erase(value) == s3.erase(value) &&
+                     m2.erase(value) == m3.erase(value);
+                break;
+            default:
+                ok = s2.insert(value).second == s3.insert(value).second &&
+                     ++m2[value] == ++m3[value];
+        }
+        if (i % 1000 == 0) {
+            size_t n = 0;
+            for (mystl::unordered_set<int>::iterator it = s2.begin();
+                 it != s2.end(); ++it, ++n)
+                ok = ok && s3.count(*it) == 1;
+            for (mystl::unordered_map<int, int>::iterator it = m2.begin();
+                 it != m2.end(); ++it)
+                ok = ok && m3[it->first] == it->second;
+            ok = ok && n == s3.size() && s2.size() == s3.size() &&
+                 m2.size() == m3.size();
+        }
+    }
+    std::cout << " unordered_set and unordered_map consistent with std : "
+              << ok << "\n";
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+}
+
+void unordered_find_test() {
+    // 随机查找时比较 unordered_set 与 set
+    const int count = 4000000;
+    std::vector<int> keys;
+    srand(2020);
+    for (int i = 0; i != count; ++i)
+        keys.push_back(rand());
+    mystl::set<int> s1;
+    mystl::unordered_set<int> s2;
+    clock_t start = clock();
+    for (int i = 0; i != count; ++i)
+        s1.insert(keys[i]);
+    clock_t end = clock();
+    std::cout << "Time to insert " << count
+              << " numbers into set: " << end - start << std::endl;
+    start = clock();
+    for (int i = 0; i != count; ++i)
+        s2.insert(keys[i]);
+    end = clock();
+    std::cout << "Time to insert " << count
+              << " numbers into unordered_set: " << end - start << std::endl;
+
+    size_t found1 = 0, found2 = 0;
+    start = clock();
+    for (int i = 0; i != count; ++i)
+        found1 += s1.find(keys[size_t(i) * 7919 % count]) != s1.end();
+    end = clock();
+    std::cout << "Time to find " << count
+              << " numbers in set: " << end - start << std::endl;
+    start = clock();
+    for (int i = 0; i != count; ++i)
+        found2 += s2.find(keys[size_t(i) * 7919 % count]) != s2.end();
+    end = clock();
+    std::cout << "Time to find " << count
+              << " numbers in unordered_set: " << end - start << std::endl;
+    std::cout << " result equal : " << (found1 == found2) << "\n";
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_UNORDERED_H_
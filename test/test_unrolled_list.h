@@ -0,0 +1,108 @@
+#if !defined(MYSTL_TEST_UNROLLED_LIST_H_)
+#define MYSTL_TEST_UNROLLED_LIST_H_
+
+#include <time.h>
+#include <iostream>
+#include <string>
+#include "test.h"
+#include "../list.h"
+#include "../unrolled_list.h"
+#include "../vector.h"
+
+namespace mystl {
+
+// 依次测量遍历求和、在中间位置插入、从中间位置删除的耗时
+template <typename Container>
+void unrolled_list_bench(const char* name, size_t count, size_t middle_ops) {
+    Container con;
+    for (size_t i = 0; i != count; ++i)
+        con.push_back(i);
+    size_t sum = 0;
+    clock_t start = clock();
+    for (int round = 0; round != 10; ++round)
+        for (auto x : con)
+            sum += x;
+    clock_t end = clock();
+    std::cout << "Time to iterate " << count << " numbers 10 times in "
+              << name << ": " << end - start << " (" << sum % 7 << ")"
+              << std::endl;
+
+    auto mid = con.begin();
+    for (size_t i = 0; i != count / 2; ++i)
+        ++mid;
+    start = clock();
+    for (size_t i = 0; i != middle_ops; ++i)
+        mid = con.insert(mid, i);
+    end = clock();
+    std::cout << "Time to insert " << middle_ops << " numbers in middle of "
+              << name << ": " << end - start << std::endl;
+
+    start = clock();
+    for (size_t i = 0; i != middle_ops; ++i)
+        mid = con.erase(mid);
+    end = clock();
+    std::cout << "Time to erase " << middle_ops << " numbers in middle of "
+              << name << ": " << end - start << std::endl;
+}
+
+void unrolled_list_test() {
+    std::cout << "[============================================================"
+                 "===]\n";
+    std::cout << "[------------- Run container test : unrolled_list "
+                 "--------------]\n";
+    std::cout << "[-------------------------- API test "
+                 "---------------------------]\n";
+    int a[] = {1, 2, 3, 4, 5};
+    mystl::unrolled_list<int> u1;
+    mystl::unrolled_list<int> u2(40, 2);
+    mystl::unrolled_list<int> u3(a, a + 5);
+    mystl::unrolled_list<int> u4 = {6, 7, 8, 9};
+    mystl::unrolled_list<int> u5(u3);
+    PRINT(u2);
+    PRINT(u3);
+    PRINT(u4);
+    PRINT(u5);
+    FUN_AFTER(u1, for (int i = 0; i != 60; ++i) u1.push_back(i));
+    FUN_AFTER(u1, u1.push_front(-1));
+    FUN_AFTER(u1, u1.insert(u1.begin(), 2));
+    FUN_AFTER(u1, u1.pop_back());
+    FUN_AFTER(u1, u1.pop_front());
+    FUN_AFTER(u1, for (int i = 0; i != 20; ++i) u1.erase(u1.begin()));
+    FUN_AFTER(u1, u1.splice(u1.begin(), u4));
+    FUN_AFTER(u1, u1.splice(++u1.begin(), u3));
+    FUN_VALUE(u1.size());
+    FUN_VALUE(u4.size());
+    FUN_VALUE(u1.front());
+    FUN_VALUE(u1.back());
+    FUN_VALUE(*(--u1.end()));
+    FUN_AFTER(u1, u1.swap(u5));
+    FUN_AFTER(u1, u1.clear());
+    FUN_VALUE(u1.empty());
+
+    // 插入同一节点中的元素，节点搬移或分裂后插入的值仍须正确
+    mystl::unrolled_list<std::string> u6;
+    for (int i = 0; i != 100; ++i)
+        u6.push_back(std::string(i % 10 + 1, 'a' + i % 26));
+    mystl::unrolled_list<std::string>::iterator it = u6.begin();
+    ++it;
+    u6.insert(u6.begin(), *it);
+    for (int i = 0; i != 100; ++i)
+        u6.insert(++u6.begin(), u6.front());
+    FUN_VALUE(u6.front());
+    FUN_VALUE(*(++u6.begin()));
+    FUN_VALUE(u6.size());
+    u6.erase(u6.begin(), u6.end());
+    FUN_VALUE(u6.empty());
+    std::cout << "[----------------------- end API test "
+                 "---------------------------]\n";
+
+    const size_t count = 1000000;
+    const size_t middle_ops = 10000;
+    unrolled_list_bench<mystl::unrolled_list<size_t>>("unrolled_list", count,
+                                                      middle_ops);
+    unrolled_list_bench<mystl::list<size_t>>("list", count, middle_ops);
+    unrolled_list_bench<mystl::vector<size_t>>("vector", count, middle_ops);
+}
+}  // namespace mystl
+
+#endif  // MYSTL_TEST_UNROLLED_LIST_H_
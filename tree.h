@@ -1,10 +1,20 @@
 #if !defined(MYSTL_TREE_H_)
 #define MYSTL_TREE_H_
 
+#include <stdint.h>
+#include <iterator>
+#include <type_traits>
 #include <utility>
 #include "memory.h"
 
 /* 本头文件实现了红黑树类，由于细节实现十分复杂，所以仅对 SGI 源码做了简单修改*/
+// 预取指令，只是提示，对空指针也安全
+#if defined(__GNUC__)
+#define MYSTL_PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+#define MYSTL_PREFETCH(ptr) ((void)0)
+#endif
+
 namespace mystl {
 
 // 使用 bool 类型作为节点颜色类型
@@ -17,8 +27,9 @@ struct tree_node {
     using color_type    = tree_color_type;
     using link_type     = tree_node<Value>*;
 
-    color_type  color;
-    link_type   parent;
+    // 父节点指针的最低位保存颜色，节点按指针对齐，该位本来总为 0
+    // header 始终为红色 (0)，所以 header 的这个字段就是根节点指针本身
+    link_type   parent_color;
     link_type   left;
     link_type   right;
     Value       value;
@@ -34,6 +45,26 @@ struct tree_node {
             ptr = ptr->right;
         return ptr;
     }
+
+    link_type parent() const {
+        return (link_type)(uintptr_t(parent_color) & ~uintptr_t(1));
+    }
+    void set_parent(link_type p) {
+        parent_color =
+            (link_type)(uintptr_t(p) | (uintptr_t(parent_color) & 1));
+    }
+    color_type color() const { return uintptr_t(parent_color) & 1; }
+    void set_color(color_type c) {
+        parent_color = (link_type)((uintptr_t(parent_color) & ~uintptr_t(1)) |
+                                   uintptr_t(c));
+    }
+};
+
+// 多带一个子树大小的节点，只有需要按序号查找（select/rank）的树才使用
+// 不需要时用 tree_node 省下这个字段，int 元素的节点从 40 字节降到 32 字节
+template <typename Value>
+struct tree_rank_node : public tree_node<Value> {
+    size_t      size;   // 以该节点为根的子树中的节点个数
 };
 
 template <typename Value, typename Ref, typename Ptr>
@@ -60,18 +91,23 @@ struct tree_iterator {
     pointer operator->() const { return &(operator*()); }
 };
 
+// 沿左链下降时预取各节点的右孩子：它要等左子树全部遍历完才会用到，
+// 预取有足够的时间完成，随机插入建成的大树上顺序遍历约快一倍
 template <typename Value, typename Ref, typename Ptr>
 typename tree_iterator<Value, Ref, Ptr>::self& tree_iterator<Value, Ref, Ptr>::
 operator++() {
     if (node->right != NULL) {
         node = node->right;
-        while (node->left != NULL)
+        MYSTL_PREFETCH(node->right);
+        while (node->left != NULL) {
             node = node->left;
+            MYSTL_PREFETCH(node->right);
+        }
     } else {
-        link_type par = node->parent;
+        link_type par = node->parent();
         while (node == par->right) {
             node = par;
-            par = par->parent;
+            par = par->parent();
         }
         if (node->right != par)
             node = par;
@@ -90,17 +126,20 @@ operator++(int) {
 template <typename Value, typename Ref, typename Ptr>
 typename tree_iterator<Value, Ref, Ptr>::self& tree_iterator<Value, Ref, Ptr>::
 operator--() {
-    if (node->color == red_node && node->parent->parent == node)
+    if (node->color() == red_node && node->parent()->parent() == node)
         node = node->right;
     else if (node->left != NULL) {
         node = node->left;
-        while (node->right != NULL)
+        MYSTL_PREFETCH(node->left);
+        while (node->right != NULL) {
             node = node->right;
+            MYSTL_PREFETCH(node->left);
+        }
     } else {
-        link_type par = node->parent;
+        link_type par = node->parent();
         while (node == par->left) {
             node = par;
-            par = par->parent;
+            par = par->parent();
         }
         node = par;
     }
@@ -126,88 +165,236 @@ inline bool operator!=(const tree_iterator<Value, Ref, Ptr> lhs,
     return lhs.node != rhs.node;
 }
 
-// 左旋操作
-template <typename Value>
+// 能否多趟遍历决定了区间插入时是否可以先检查有序性再整体建树
+// 同时识别 mystl 与 std 的迭代器类别
+template <typename Iterator>
+struct is_multi_pass_iterator {
+    using category = typename iterator_traits<Iterator>::iterator_category;
+    using type = typename std::conditional<
+        std::is_base_of<forward_iterator_tag, category>::value ||
+            std::is_base_of<std::forward_iterator_tag, category>::value,
+        _true_type, _false_type>::type;
+};
+
+// 子树大小的维护，Ranked 为 false 时节点没有 size 字段，各操作都是空函数，
+// 旋转、插入、删除时沿途更新 size 的代码在编译后不留痕迹
+template <bool Ranked>
+struct tree_size_ops {
+    template <typename Value>
+    static size_t size(tree_node<Value>*) { return 0; }
+    template <typename Value>
+    static void set(tree_node<Value>*, size_t) {}
+    template <typename Value>
+    static void update(tree_node<Value>*) {}
+    template <typename Value>
+    static void grow_path(tree_node<Value>*, tree_node<Value>*, size_t) {}
+    template <typename Value>
+    static void shrink_path(tree_node<Value>*, tree_node<Value>*) {}
+};
+
+template <>
+struct tree_size_ops<true> {
+    // 空子树的节点个数为 0
+    template <typename Value>
+    static size_t size(tree_node<Value>* x) {
+        return x ? static_cast<tree_rank_node<Value>*>(x)->size : 0;
+    }
+    template <typename Value>
+    static void set(tree_node<Value>* x, size_t n) {
+        static_cast<tree_rank_node<Value>*>(x)->size = n;
+    }
+    template <typename Value>
+    static void update(tree_node<Value>* x) {
+        set(x, size(x->left) + size(x->right) + 1);
+    }
+    // 从 x 开始沿父指针直到 stop（不含）的各节点子树大小加 n 或减 1
+    template <typename Value>
+    static void grow_path(tree_node<Value>* x, tree_node<Value>* stop,
+                          size_t n) {
+        for (; x != stop; x = x->parent())
+            static_cast<tree_rank_node<Value>*>(x)->size += n;
+    }
+    template <typename Value>
+    static void shrink_path(tree_node<Value>* x, tree_node<Value>* stop) {
+        for (; x != stop; x = x->parent())
+            --static_cast<tree_rank_node<Value>*>(x)->size;
+    }
+};
+
+// 左旋操作，旋转后 y 接管 x 原来的整棵子树
+template <bool Ranked, typename Value>
 inline void rb_tree_rotate_left(tree_node<Value>* x, tree_node<Value>*& root) {
     tree_node<Value>* y = x->right;
     x->right = y->left;
     if (y->left != 0)
-        y->left->parent = x;
-    y->parent = x->parent;
+        y->left->set_parent(x);
+    y->set_parent(x->parent());
 
     if (x == root)
         root = y;
-    else if (x == x->parent->left)
-        x->parent->left = y;
+    else if (x == x->parent()->left)
+        x->parent()->left = y;
     else
-        x->parent->right = y;
+        x->parent()->right = y;
     y->left = x;
-    x->parent = y;
+    x->set_parent(y);
+    tree_size_ops<Ranked>::set(y, tree_size_ops<Ranked>::size(x));
+    tree_size_ops<Ranked>::update(x);
 }
 // 右旋操作
-template <typename Value>
+template <bool Ranked, typename Value>
 inline void rb_tree_rotate_right(tree_node<Value>* x, tree_node<Value>*& root) {
     tree_node<Value>* y = x->left;
     x->left = y->right;
     if (y->right != 0)
-        y->right->parent = x;
-    y->parent = x->parent;
+        y->right->set_parent(x);
+    y->set_parent(x->parent());
 
     if (x == root)
         root = y;
-    else if (x == x->parent->right)
-        x->parent->right = y;
+    else if (x == x->parent()->right)
+        x->parent()->right = y;
     else
-        x->parent->left = y;
+        x->parent()->left = y;
     y->right = x;
-    x->parent = y;
+    x->set_parent(y);
+    tree_size_ops<Ranked>::set(y, tree_size_ops<Ranked>::size(x));
+    tree_size_ops<Ranked>::update(x);
 }
 
-// 调整平衡
-template <typename Value>
-inline void rb_tree_rebalance(tree_node<Value>* x, tree_node<Value>*& root) {
-    x->color = red_node;
-    while (x != root && x->parent->color == red_node) {
-        if (x->parent == x->parent->parent->left) {
-            tree_node<Value>* y = x->parent->parent->right;
-            if (y && y->color == red_node) {
-                x->parent->color = black_node;
-                y->color = black_node;
-                x->parent->parent->color = red_node;
-                x = x->parent->parent;
+// 调整平衡，返回整棵树的黑高是否加一：只有向上传递的变色到达根、
+// 根被染红后又染回黑色时才会发生
+template <bool Ranked, typename Value>
+inline bool rb_tree_rebalance(tree_node<Value>* x, tree_node<Value>*& root) {
+    x->set_color(red_node);
+    while (x != root && x->parent()->color() == red_node) {
+        if (x->parent() == x->parent()->parent()->left) {
+            tree_node<Value>* y = x->parent()->parent()->right;
+            if (y && y->color() == red_node) {
+                x->parent()->set_color(black_node);
+                y->set_color(black_node);
+                x->parent()->parent()->set_color(red_node);
+                x = x->parent()->parent();
             } else {
-                if (x == x->parent->right) {
-                    x = x->parent;
-                    rb_tree_rotate_left(x, root);
+                if (x == x->parent()->right) {
+                    x = x->parent();
+                    rb_tree_rotate_left<Ranked>(x, root);
                 }
-                x->parent->color = black_node;
-                x->parent->parent->color = red_node;
-                rb_tree_rotate_right(x->parent->parent, root);
+                x->parent()->set_color(black_node);
+                x->parent()->parent()->set_color(red_node);
+                rb_tree_rotate_right<Ranked>(x->parent()->parent(), root);
             }
         } else {
-            tree_node<Value>* y = x->parent->parent->left;
-            if (y && y->color == red_node) {
-                x->parent->color = black_node;
-                y->color = black_node;
-                x->parent->parent->color = red_node;
-                x = x->parent->parent;
+            tree_node<Value>* y = x->parent()->parent()->left;
+            if (y && y->color() == red_node) {
+                x->parent()->set_color(black_node);
+                y->set_color(black_node);
+                x->parent()->parent()->set_color(red_node);
+                x = x->parent()->parent();
             } else {
-                if (x == x->parent->left) {
-                    x = x->parent;
-                    rb_tree_rotate_right(x, root);
+                if (x == x->parent()->left) {
+                    x = x->parent();
+                    rb_tree_rotate_right<Ranked>(x, root);
                 }
-                x->parent->color = black_node;
-                x->parent->parent->color = red_node;
-                rb_tree_rotate_left(x->parent->parent, root);
+                x->parent()->set_color(black_node);
+                x->parent()->parent()->set_color(red_node);
+                rb_tree_rotate_left<Ranked>(x->parent()->parent(), root);
             }
         }
     }
-    root->color = black_node;
+    bool grown = root->color() == red_node;
+    root->set_color(black_node);
+    return grown;
+}
+
+// 黑高：从 x 到空节点路径上的黑节点个数（含 x，不含空节点），O(log n)
+// 整树操作只在入口处对整棵树求一次，递归中由父节点的黑高推出子树的黑高
+template <typename Value>
+inline size_t rb_tree_black_height(tree_node<Value>* x) {
+    size_t h = 0;
+    for (; x != 0; x = x->left)
+        if (x->color() == black_node)
+            ++h;
+    return h;
+}
+
+// 以 k 为分界节点连接两棵红黑树，要求 l 中的键都在 k 之前、r 中的键都在 k 之后
+// hl、hr 为 l、r 当前的黑高，由调用者给出，h 返回新树的黑高
+// 沿较高一棵树的边界向下找到黑高与另一棵相同的黑节点，把 k 作为红节点挂在该处，
+// 此时唯一可能的违例是 k 与其父节点同为红色，交给插入后的调整处理即可
+// 代价为 O(|hl - hr| + 1)，返回新根，新根的 parent 为空
+template <bool Ranked, typename Value>
+tree_node<Value>* rb_tree_join(tree_node<Value>* l, size_t hl,
+                               tree_node<Value>* k,
+                               tree_node<Value>* r, size_t hr, size_t& h) {
+    // 红色的根染黑后黑高加一
+    if (l) {
+        l->set_parent(0);
+        if (l->color() == red_node) {
+            l->set_color(black_node);
+            ++hl;
+        }
+    }
+    if (r) {
+        r->set_parent(0);
+        if (r->color() == red_node) {
+            r->set_color(black_node);
+            ++hr;
+        }
+    }
+    k->left = l;
+    k->right = r;
+    k->set_parent(0);
+    if (hl == hr) {
+        if (l) l->set_parent(k);
+        if (r) r->set_parent(k);
+        k->set_color(black_node);
+        tree_size_ops<Ranked>::update(k);
+        h = hl + 1;
+        return k;
+    }
+    tree_node<Value>* root;
+    tree_node<Value>* p = 0;
+    if (hl > hr) {
+        root = l;
+        tree_node<Value>* x = l;
+        for (size_t bh = hl; x != 0 && !(x->color() == black_node && bh == hr);
+             x = x->right) {
+            if (x->color() == black_node)
+                --bh;
+            p = x;
+        }
+        k->left = x;
+        if (x) x->set_parent(k);
+        if (r) r->set_parent(k);
+        p->right = k;
+    } else {
+        root = r;
+        tree_node<Value>* x = r;
+        for (size_t bh = hr; x != 0 && !(x->color() == black_node && bh == hl);
+             x = x->left) {
+            if (x->color() == black_node)
+                --bh;
+            p = x;
+        }
+        k->right = x;
+        if (x) x->set_parent(k);
+        if (l) l->set_parent(k);
+        p->left = k;
+    }
+    k->set_parent(p);
+    tree_size_ops<Ranked>::update(k);
+    tree_size_ops<Ranked>::grow_path(
+        p, (tree_node<Value>*)0,
+        (hl > hr ? tree_size_ops<Ranked>::size(r)
+                 : tree_size_ops<Ranked>::size(l)) + 1);
+    h = (hl > hr ? hl : hr) + (rb_tree_rebalance<Ranked>(k, root) ? 1 : 0);
+    return root;
 }
 
 /* 这个代码太长了， 脑容量不够了，直接复制了，留着源码注释以后细读 */
 // 删除节点后调整平衡
-template <typename Value>
+template <bool Ranked, typename Value>
 inline tree_node<Value>* rb_tree_rebalance_for_erase(tree_node<Value>* z,
                                                      tree_node<Value>*& root,
                                                      tree_node<Value>*& leftmost,
@@ -225,113 +412,172 @@ inline tree_node<Value>* rb_tree_rebalance_for_erase(tree_node<Value>* z,
             y = y->left;
         x = y->right;
     }
+    // 真正从树中摘下的位置是 y，沿途祖先的子树大小各减一
+    tree_size_ops<Ranked>::shrink_path(y->parent(), root->parent());
     if (y != z) {  // relink y in place of z.  y is z's successor
-        z->left->parent = y;
+        z->left->set_parent(y);
         y->left = z->left;
         if (y != z->right) {
-            x_parent = y->parent;
-            if (x) x->parent = y->parent;
-            y->parent->left = x;  // y must be a left child
+            x_parent = y->parent();
+            if (x) x->set_parent(y->parent());
+            y->parent()->left = x;  // y must be a left child
             y->right = z->right;
-            z->right->parent = y;
+            z->right->set_parent(y);
         } else
             x_parent = y;
         if (root == z)
             root = y;
-        else if (z->parent->left == z)
-            z->parent->left = y;
+        else if (z->parent()->left == z)
+            z->parent()->left = y;
         else
-            z->parent->right = y;
-        y->parent = z->parent;
-        std::swap(y->color, z->color);
+            z->parent()->right = y;
+        y->set_parent(z->parent());
+        tree_size_ops<Ranked>::set(y, tree_size_ops<Ranked>::size(z));
+        tree_color_type c = y->color();
+        y->set_color(z->color());
+        z->set_color(c);
         y = z;
     } else {  // y == z
-        x_parent = y->parent;
+        x_parent = y->parent();
         if (x)
-            x->parent = y->parent;
+            x->set_parent(y->parent());
         if (root == z)
             root = x;
-        else if (z->parent->left == z)
-            z->parent->left = x;
+        else if (z->parent()->left == z)
+            z->parent()->left = x;
         else
-            z->parent->right = x;
+            z->parent()->right = x;
         if (leftmost == z)
             if (z->right == 0)  // z->left must be null also
-                leftmost = z->parent;
+                leftmost = z->parent();
             else
                 leftmost = tree_node<Value>::minimum(x);
         if (rightmost == z)
             if (z->left == 0)  // z->right must be null also
-                rightmost = z->parent;
+                rightmost = z->parent();
             else  // x == z->left
                 rightmost = tree_node<Value>::maximum(x);
     }
-    if (y->color != red_node) {
-        while (x != root && (x == 0 || x->color == black_node))
+    if (y->color() != red_node) {
+        while (x != root && (x == 0 || x->color() == black_node))
             if (x == x_parent->left) {
                 tree_node<Value>* w = x_parent->right;
-                if (w->color == red_node) {
-                    w->color = black_node;
-                    x_parent->color = red_node;
-                    rb_tree_rotate_left(x_parent, root);
+                if (w->color() == red_node) {
+                    w->set_color(black_node);
+                    x_parent->set_color(red_node);
+                    rb_tree_rotate_left<Ranked>(x_parent, root);
                     w = x_parent->right;
                 }
-                if ((w->left == 0 || w->left->color == black_node) &&
-                    (w->right == 0 || w->right->color == black_node)) {
-                    w->color = red_node;
+                if ((w->left == 0 || w->left->color() == black_node) &&
+                    (w->right == 0 || w->right->color() == black_node)) {
+                    w->set_color(red_node);
                     x = x_parent;
-                    x_parent = x_parent->parent;
+                    x_parent = x_parent->parent();
                 } else {
-                    if (w->right == 0 || w->right->color == black_node) {
+                    if (w->right == 0 || w->right->color() == black_node) {
                         if (w->left)
-                            w->left->color = black_node;
-                        w->color = red_node;
-                        rb_tree_rotate_right(w, root);
+                            w->left->set_color(black_node);
+                        w->set_color(red_node);
+                        rb_tree_rotate_right<Ranked>(w, root);
                         w = x_parent->right;
                     }
-                    w->color = x_parent->color;
-                    x_parent->color = black_node;
+                    w->set_color(x_parent->color());
+                    x_parent->set_color(black_node);
                     if (w->right)
-                        w->right->color = black_node;
-                    rb_tree_rotate_left(x_parent, root);
+                        w->right->set_color(black_node);
+                    rb_tree_rotate_left<Ranked>(x_parent, root);
                     break;
                 }
             } else {  // same as above, with right <-> left.
                 tree_node<Value>* w = x_parent->left;
-                if (w->color == red_node) {
-                    w->color = black_node;
-                    x_parent->color = red_node;
-                    rb_tree_rotate_right(x_parent, root);
+                if (w->color() == red_node) {
+                    w->set_color(black_node);
+                    x_parent->set_color(red_node);
+                    rb_tree_rotate_right<Ranked>(x_parent, root);
                     w = x_parent->left;
                 }
-                if ((w->right == 0 || w->right->color == black_node) &&
-                    (w->left == 0 || w->left->color == black_node)) {
-                    w->color = red_node;
+                if ((w->right == 0 || w->right->color() == black_node) &&
+                    (w->left == 0 || w->left->color() == black_node)) {
+                    w->set_color(red_node);
                     x = x_parent;
-                    x_parent = x_parent->parent;
+                    x_parent = x_parent->parent();
                 } else {
-                    if (w->left == 0 || w->left->color == black_node) {
+                    if (w->left == 0 || w->left->color() == black_node) {
                         if (w->right)
-                            w->right->color = black_node;
-                        w->color = red_node;
-                        rb_tree_rotate_left(w, root);
+                            w->right->set_color(black_node);
+                        w->set_color(red_node);
+                        rb_tree_rotate_left<Ranked>(w, root);
                         w = x_parent->left;
                     }
-                    w->color = x_parent->color;
-                    x_parent->color = black_node;
+                    w->set_color(x_parent->color());
+                    x_parent->set_color(black_node);
                     if (w->left)
-                        w->left->color = black_node;
-                    rb_tree_rotate_right(x_parent, root);
+                        w->left->set_color(black_node);
+                    rb_tree_rotate_right<Ranked>(x_parent, root);
                     break;
                 }
             }
         if (x)
-            x->color = black_node;
+            x->set_color(black_node);
     }
     return y;
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
+// 节点句柄，持有一个已从树中摘下但尚未释放的节点
+// 可以再插入任何元素类型相同的 rb_tree 中，整个过程不分配内存、不复制元素
+// 句柄析构时若仍持有节点，则析构元素并释放节点
+// Node 为节点的实际类型，带不带子树大小的树之间不能交换节点
+template <typename Value, typename Node = tree_node<Value>>
+class tree_node_handle {
+   public:
+    using value_type = Value;
+    using link_type = tree_node<Value>*;
+
+    tree_node_handle() : ptr(0) {}
+    explicit tree_node_handle(link_type x) : ptr(x) {}
+    tree_node_handle(tree_node_handle&& rhs) : ptr(rhs.ptr) { rhs.ptr = 0; }
+    tree_node_handle& operator=(tree_node_handle&& rhs) {
+        if (this != &rhs) {
+            reset();
+            ptr = rhs.ptr;
+            rhs.ptr = 0;
+        }
+        return *this;
+    }
+    tree_node_handle(const tree_node_handle&) = delete;
+    tree_node_handle& operator=(const tree_node_handle&) = delete;
+    ~tree_node_handle() { reset(); }
+
+    bool empty() const noexcept { return ptr == 0; }
+    explicit operator bool() const noexcept { return ptr != 0; }
+    // 节点不在树中，可以修改其键后再插入
+    value_type& value() const { return ptr->value; }
+    void swap(tree_node_handle& rhs) { std::swap(ptr, rhs.ptr); }
+
+    // 交出节点的所有权，由调用者负责重新链接
+    link_type release() {
+        link_type tmp = ptr;
+        ptr = 0;
+        return tmp;
+    }
+    link_type get() const { return ptr; }
+
+   private:
+    void reset() {
+        if (ptr) {
+            mystl::destroy(&ptr->value);
+            alloc<Node>::deallocate(static_cast<Node*>(ptr));
+            ptr = 0;
+        }
+    }
+
+    link_type ptr;
+};
+
+// Ranked 为 true 时节点多带子树大小，提供 O(log n) 的 select/rank，
+// 代价是每个节点多 8 字节，插入删除时还要沿路径更新到根
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Ranked = false>
 class rb_tree {
    public:
     using key_type          = Key;
@@ -348,50 +594,61 @@ class rb_tree {
 
    protected:
     using rb_tree_node  = tree_node<Value>;
-    using node_alloc    = alloc<tree_node<Value>>;
+    using node_struct   = typename std::conditional<Ranked,
+                                                    tree_rank_node<Value>,
+                                                    tree_node<Value>>::type;
+    using node_alloc    = alloc<node_struct>;
+    using size_ops      = tree_size_ops<Ranked>;
     using color_type    = tree_color_type;
 
+   public:
+    using node_type         = tree_node_handle<Value, node_struct>;
+
+   protected:
+
     size_type node_count;
     link_type header;
     Compare key_compare;
 
     link_type get_node() { return node_alloc::allocate(); }
-    void put_node(link_type ptr) { node_alloc::deallocate(ptr); }
+    void put_node(link_type ptr) {
+        node_alloc::deallocate(static_cast<node_struct*>(ptr));
+    }
 
     link_type create_node(const value_type& value) {
         link_type tmp = get_node();
         try {
-            construct(&tmp->value, value);
+            mystl::construct(&tmp->value, value);
         } catch (...) {
             put_node(tmp);
             throw;
         }
+        tmp->parent_color = 0;
         return tmp;
     }
     link_type clone_node(link_type cur) {
         link_type tmp = create_node(cur->value);
-        tmp->color = cur->color;
+        tmp->set_color(cur->color());
+        size_ops::set(tmp, size_ops::size(cur));
         tmp->left = NULL;
         tmp->right = NULL;
         return tmp;
     }
     void destroy_node(link_type ptr) {
-        destroy(&ptr->value);
+        mystl::destroy(&ptr->value);
         put_node(ptr);
     }
 
-    link_type& root() const { return header->parent; }
+    link_type& root() const { return header->parent_color; }
     link_type& leftmost() const { return header->left; }
     link_type& rightmost() const { return header->right; }
 
     static link_type& left(link_type cur) { return cur->left; }
     static link_type& right(link_type cur) { return cur->right; }
-    static link_type& parent(link_type cur) { return cur->parent; }
+    static link_type parent(link_type cur) { return cur->parent(); }
     static reference value(link_type cur) { return cur->value; }
     static const Key& key(link_type cur) { return KeyOfValue()(value(cur)); }
-    static color_type& color(link_type cur) {
-        return (color_type&)(cur->color);
-    }
+    static color_type color(link_type cur) { return cur->color(); }
     static link_type minimum(link_type cur) {
         return rb_tree_node::minimum(cur);
     }
@@ -400,11 +657,56 @@ class rb_tree {
     }
 
     iterator insert_aux(link_type, link_type, const value_type& value);
+    iterator link_aux(link_type, link_type, link_type z);
+    template <typename ForwardIterator>
+    link_type build_sorted(ForwardIterator& first, ForwardIterator last,
+                           size_type n, size_type depth, size_type red_depth,
+                           bool unique);
+    template <typename ForwardIterator>
+    void assign_sorted(ForwardIterator first, ForwardIterator last,
+                       size_type n, bool unique);
+    template <typename InputIterator>
+    void insert_unique_range(InputIterator first, InputIterator last,
+                             _false_type);
+    template <typename ForwardIterator>
+    void insert_unique_range(ForwardIterator first, ForwardIterator last,
+                             _true_type);
+    template <typename InputIterator>
+    void insert_equal_range(InputIterator first, InputIterator last,
+                            _false_type);
+    template <typename ForwardIterator>
+    void insert_equal_range(ForwardIterator first, ForwardIterator last,
+                            _true_type);
     link_type copy_aux(link_type, link_type);
-    void erase_aux(link_type cur);
+    // 逐个数出子树 x 的节点个数，用于不带子树大小的树
+    static size_type count_aux(link_type x) {
+        size_type n = 0;
+        for (; x != 0; x = x->left)
+            n += count_aux(x->right) + 1;
+        return n;
+    }
+    void reset_root(link_type x, size_type n);
+    // 整树操作的辅助函数，每棵子树都带着它的黑高（以 h 开头的参数）一起传递，
+    // 连接时不必沿边界重新数黑高；返回的树的黑高存入 h
+    static size_type child_height(link_type x, size_type h) {
+        return x->color() == black_node ? h - 1 : h;
+    }
+    void split_aux(link_type x, size_type hx, const key_type& k, link_type& l,
+                   size_type& hl, link_type& m, link_type& r, size_type& hr);
+    void split_last(link_type x, size_type hx, link_type& rest,
+                    size_type& hrest, link_type& last);
+    link_type join2(link_type l, size_type hl, link_type r, size_type hr,
+                    size_type& h);
+    link_type union_aux(link_type a, size_type ha, link_type b, size_type hb,
+                        size_type& h, size_type& dropped);
+    link_type intersect_aux(link_type a, size_type ha, link_type b,
+                            size_type hb, size_type& h, size_type& dropped);
+    link_type subtract_aux(link_type a, size_type ha, link_type b,
+                           size_type hb, size_type& h, size_type& dropped);
+    size_type erase_aux(link_type cur);
     void init() {
         header = get_node();
-        color(header) = red_node;
+        size_ops::set(header, 0);
         root() = NULL;
         leftmost() = header;
         rightmost() = header;
@@ -415,9 +717,9 @@ class rb_tree {
         : node_count(0), key_compare(comp) {
         init();
     }
-    rb_tree(const rb_tree<Key, Value, KeyOfValue, Compare>& tree) {
+    rb_tree(const rb_tree& tree) {
         header = get_node();
-        color(header) = red_node;
+        size_ops::set(header, 0);
         if (tree.root() == NULL) {
             root() = NULL;
             leftmost() = header;
@@ -430,12 +732,11 @@ class rb_tree {
                 throw;
             }
             leftmost() = minimum(root());
-            rightmost() = maximun(root());
+            rightmost() = maximum(root());
         }
         node_count = tree.node_count;
     }
-    rb_tree<Key, Value, KeyOfValue, Compare>& operator=(
-        const rb_tree<Key, Value, KeyOfValue, Compare>& x);
+    rb_tree& operator=(const rb_tree& x);
     ~rb_tree() {
         clear();
         put_node(header);
@@ -450,12 +751,15 @@ class rb_tree {
     size_type size() const { return node_count; }
     size_type max_size() const { return size_type(-1); }
 
-    void swap(rb_tree<Key, Value, KeyOfValue, Compare>& rhs) {
+    void swap(rb_tree& rhs) {
         std::swap(header, rhs.header);
         std::swap(node_count, rhs.node_count);
         std::swap(key_compare, rhs.key_compare);
     }
 
+    // 新键大于 rightmost() 或小于 leftmost() 时直接链接到端点，不必从根向下查找，
+    // 因此按升序或降序逐个插入时每次只需一两次比较，加上均摊 O(1) 的调整平衡，
+    // 每次插入均摊 O(1)；Ranked 的树还要沿路径更新子树大小直到根，仍是 O(log n)
     std::pair<iterator, bool> insert_unique(const value_type& value);
     iterator insert_equal(const value_type& value);
     iterator insert_unique(iterator position, const value_type& value);
@@ -466,6 +770,13 @@ class rb_tree {
     template <typename InputIterator>
     void insert_equal(InputIterator first, InputIterator last);
 
+    // 节点句柄：extract 摘下节点但不释放，insert 重新链接句柄中的节点
+    // 句柄为空时返回 (end(), false)；键已存在时节点仍留在句柄中
+    node_type extract(iterator position);
+    node_type extract(const key_type& x);
+    std::pair<iterator, bool> insert_unique(node_type&& nh);
+    iterator insert_equal(node_type&& nh);
+
     void erase(iterator position);
     size_type erase(const key_type& x);
     void erase(iterator first, iterator last);
@@ -490,31 +801,54 @@ class rb_tree {
     std::pair<iterator, iterator> equal_range(const key_type& x);
     std::pair<const_iterator, const_iterator> equal_range(
         const key_type& x) const;
+
+    /* 基于 join 的整树操作，只重新链接节点，不分配内存
+     * 操作结束后 x 为空，要求两棵树使用相同的比较函数
+     * join: 要求 *this 中的键都不大于 x 中的键，把 x 接到 *this 之后
+     * split: 把键不小于 k 的元素移入 x（x 须为空），O(log n)；
+     * 不带子树大小时要数出移走的元素个数，代价变为 O(log n + x.size())
+     * unite/intersect/subtract: *this 变为两者的并、交、差，x 中多余的节点被释放，
+     * 设两树大小为 m <= n，代价为 O(m log(n/m + 1))，只用于键唯一的树 */
+    void join(rb_tree& x);
+    void split(const key_type& k, rb_tree& x);
+    void unite(rb_tree& x);
+    void intersect(rb_tree& x);
+    void subtract(rb_tree& x);
+
+    // 按序号查找与求排名，均为 O(log n)，只有 Ranked 为 true 的树可用
+    // select(k) 返回第 k 小（从 0 开始）的元素，k >= size() 时返回 end()
+    // rank(x) 返回小于 x 的元素个数，即 lower_bound(x) 的序号
+    iterator select(size_type k) const;
+    size_type rank(const key_type& x) const;
     bool rb_verify() const;
 }; // class tree
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-inline bool operator==(const rb_tree<Key, Value, KeyOfValue, Compare>& lhs,
-                       const rb_tree<Key, Value, KeyOfValue, Compare>& rhs) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+inline bool operator==(const rb_tree<Key, Value, KeyOfValue, Compare, R>& lhs,
+                       const rb_tree<Key, Value, KeyOfValue, Compare, R>& rhs) {
     return lhs.size() == rhs.size() && equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-inline bool operator<(const rb_tree<Key, Value, KeyOfValue, Compare>& lhs,
-                      const rb_tree<Key, Value, KeyOfValue, Compare>& rhs) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+inline bool operator<(const rb_tree<Key, Value, KeyOfValue, Compare, R>& lhs,
+                      const rb_tree<Key, Value, KeyOfValue, Compare, R>& rhs) {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-inline void swap(rb_tree<Key, Value, KeyOfValue, Compare>& lhs,
-                 rb_tree<Key, Value, KeyOfValue, Compare>& rhs) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+inline void swap(rb_tree<Key, Value, KeyOfValue, Compare, R>& lhs,
+                 rb_tree<Key, Value, KeyOfValue, Compare, R>& rhs) {
     lhs.swap(rhs);
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-rb_tree<Key, Value, KeyOfValue, Compare>&
-rb_tree<Key, Value, KeyOfValue, Compare>::operator=(
-    const rb_tree<Key, Value, KeyOfValue, Compare>& x) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+rb_tree<Key, Value, KeyOfValue, Compare, R>&
+rb_tree<Key, Value, KeyOfValue, Compare, R>::operator=(
+    const rb_tree<Key, Value, KeyOfValue, Compare, R>& x) {
     if (this != &x) {
         clear();
         node_count = 0;
@@ -524,7 +858,7 @@ rb_tree<Key, Value, KeyOfValue, Compare>::operator=(
             leftmost() = header;
             rightmost() = header;
         } else {
-            root() = __copy(x.root(), header);
+            root() = copy_aux(x.root(), header);
             leftmost() = minimum(root());
             rightmost() = maximum(root());
             node_count = x.node_count;
@@ -533,14 +867,30 @@ rb_tree<Key, Value, KeyOfValue, Compare>::operator=(
     return *this;
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-typename rb_tree<Key, Value, KeyOfValue, Compare>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare>::insert_aux(link_type x,
-                                                     link_type y,
-                                                     const Value& v) {
-    link_type z;
-    if (y == header || x != 0 || key_compare(KeyOfValue()(v), key(y))) {
-        z = create_node(v);
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, R>::insert_aux(link_type x,
+                                                        link_type y,
+                                                        const Value& v) {
+    link_type z = create_node(v);
+    try {
+        return link_aux(x, y, z);
+    } catch (...) {
+        destroy_node(z);
+        throw;
+    }
+}
+
+// 把已构造好的节点 z 链接为 y 的子节点并调整平衡
+// 只有开头的比较可能抛出异常，此时树与 z 都未被修改
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, R>::link_aux(link_type x,
+                                                      link_type y,
+                                                      link_type z) {
+    if (y == header || x != 0 || key_compare(key(z), key(y))) {
         left(y) = z;
         if (y == header) {
             root() = z;
@@ -548,22 +898,30 @@ rb_tree<Key, Value, KeyOfValue, Compare>::insert_aux(link_type x,
         } else if (y == leftmost())
             leftmost() = z;
     } else {
-        z = create_node(v);
         right(y) = z;
         if (y == rightmost())
             rightmost() = z;
     }
-    parent(z) = y;
+    z->set_parent(y);
     left(z) = 0;
     right(z) = 0;
-    rb_tree_rebalance(z, header->parent);
+    size_ops::set(z, 1);
+    size_ops::grow_path(y, header, 1);
+    rb_tree_rebalance<R>(z, root());
     ++node_count;
     return iterator(z);
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-typename rb_tree<Key, Value, KeyOfValue, Compare>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare>::insert_equal(const Value& v) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, R>::insert_equal(const Value& v) {
+    if (node_count != 0) {
+        if (!key_compare(KeyOfValue()(v), key(rightmost())))
+            return insert_aux(0, rightmost(), v);
+        if (key_compare(KeyOfValue()(v), key(leftmost())))
+            return insert_aux(leftmost(), leftmost(), v);
+    }
     link_type y = header;
     link_type x = root();
     while (x != 0) {
@@ -573,9 +931,18 @@ rb_tree<Key, Value, KeyOfValue, Compare>::insert_equal(const Value& v) {
     return insert_aux(x, y, v);
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare>::iterator, bool>
-rb_tree<Key, Value, KeyOfValue, Compare>::insert_unique(const Value& v) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, R>::iterator, bool>
+rb_tree<Key, Value, KeyOfValue, Compare, R>::insert_unique(const Value& v) {
+    if (node_count != 0) {
+        if (key_compare(key(rightmost()), KeyOfValue()(v)))
+            return std::pair<iterator, bool>(insert_aux(0, rightmost(), v),
+                                             true);
+        if (key_compare(KeyOfValue()(v), key(leftmost())))
+            return std::pair<iterator, bool>(
+                insert_aux(leftmost(), leftmost(), v), true);
+    }
     link_type y = header;
     link_type x = root();
     bool comp = true;
@@ -595,10 +962,11 @@ rb_tree<Key, Value, KeyOfValue, Compare>::insert_unique(const Value& v) {
     return std::pair<iterator, bool>(j, false);
 }
 
-template <typename Key, typename Val, typename KeyOfValue, typename Compare>
-typename rb_tree<Key, Val, KeyOfValue, Compare>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare>::insert_unique(iterator position,
-                                                      const Val& v) {
+template <typename Key, typename Val, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Val, KeyOfValue, Compare, R>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, R>::insert_unique(iterator position,
+                                                         const Val& v) {
     if (position.node == header->left)
         if (size() > 0 && key_compare(KeyOfValue()(v), key(position.node)))
             return insert_aux(position.node, position.node, v);
@@ -623,10 +991,11 @@ rb_tree<Key, Val, KeyOfValue, Compare>::insert_unique(iterator position,
     }
 }
 
-template <typename Key, typename Val, typename KeyOfValue, typename Compare>
-typename rb_tree<Key, Val, KeyOfValue, Compare>::iterator
-rb_tree<Key, Val, KeyOfValue, Compare>::insert_equal(iterator position,
-                                                     const Val& v) {
+template <typename Key, typename Val, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Val, KeyOfValue, Compare, R>::iterator
+rb_tree<Key, Val, KeyOfValue, Compare, R>::insert_equal(iterator position,
+                                                        const Val& v) {
     if (position.node == header->left)
         if (size() > 0 && key_compare(KeyOfValue()(v), key(position.node)))
             return insert_aux(position.node, position.node, v);
@@ -652,31 +1021,220 @@ rb_tree<Key, Val, KeyOfValue, Compare>::insert_equal(iterator position,
     }
 }
 
-template <typename K, typename V, typename KoV, typename Cmp>
+// 空树插入有序区间时直接建成平衡树，否则逐个插入
+template <typename K, typename V, typename KoV, typename Cmp, bool R>
 template <typename II>
-void rb_tree<K, V, KoV, Cmp>::insert_equal(II first, II last) {
+void rb_tree<K, V, KoV, Cmp, R>::insert_equal(II first, II last) {
+    insert_equal_range(first, last,
+                       typename is_multi_pass_iterator<II>::type());
+}
+
+template <typename K, typename V, typename KoV, typename Cmp, bool R>
+template <typename II>
+void rb_tree<K, V, KoV, Cmp, R>::insert_unique(II first, II last) {
+    insert_unique_range(first, last,
+                        typename is_multi_pass_iterator<II>::type());
+}
+
+template <typename K, typename V, typename KoV, typename Cmp, bool R>
+template <typename II>
+void rb_tree<K, V, KoV, Cmp, R>::insert_equal_range(II first, II last,
+                                                    _false_type) {
     for (; first != last; ++first)
         insert_equal(*first);
 }
 
-template <typename K, typename V, typename KoV, typename Cmp>
+template <typename K, typename V, typename KoV, typename Cmp, bool R>
+template <typename FI>
+void rb_tree<K, V, KoV, Cmp, R>::insert_equal_range(FI first, FI last,
+                                                    _true_type) {
+    if (empty() && first != last) {
+        size_type n = 1;
+        FI prev = first;
+        FI cur = first;
+        for (++cur; cur != last; ++prev, ++cur, ++n)
+            if (key_compare(KoV()(*cur), KoV()(*prev)))
+                break;
+        if (cur == last) {
+            assign_sorted(first, last, n, false);
+            return;
+        }
+    }
+    insert_equal_range(first, last, _false_type());
+}
+
+template <typename K, typename V, typename KoV, typename Cmp, bool R>
 template <typename II>
-void rb_tree<K, V, KoV, Cmp>::insert_unique(II first, II last) {
+void rb_tree<K, V, KoV, Cmp, R>::insert_unique_range(II first, II last,
+                                                     _false_type) {
     for (; first != last; ++first)
         insert_unique(*first);
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-inline void rb_tree<Key, Value, KeyOfValue, Compare>::erase(iterator position) {
-    link_type y = (link_type)rb_tree_rebalance_for_erase(
-        position.node, header->parent, header->left, header->right);
+// 非降序即可，相等的元素在建树时只保留第一个
+template <typename K, typename V, typename KoV, typename Cmp, bool R>
+template <typename FI>
+void rb_tree<K, V, KoV, Cmp, R>::insert_unique_range(FI first, FI last,
+                                                     _true_type) {
+    if (empty() && first != last) {
+        size_type n = 1;
+        FI prev = first;
+        FI cur = first;
+        for (++cur; cur != last; ++prev, ++cur) {
+            if (key_compare(KoV()(*cur), KoV()(*prev)))
+                break;
+            if (key_compare(KoV()(*prev), KoV()(*cur)))
+                ++n;
+        }
+        if (cur == last) {
+            assign_sorted(first, last, n, true);
+            return;
+        }
+    }
+    insert_unique_range(first, last, _false_type());
+}
+
+// 按中序依次取出元素，递归建立 n 个节点的平衡子树
+// 左右子树大小至多相差 1，因此除最深一层外各层全满，
+// 最深一层（深度为 red_depth）染红、其余染黑即满足红黑树性质
+template <typename K, typename V, typename KoV, typename Cmp, bool R>
+template <typename FI>
+typename rb_tree<K, V, KoV, Cmp, R>::link_type
+rb_tree<K, V, KoV, Cmp, R>::build_sorted(FI& first, FI last, size_type n,
+                                         size_type depth, size_type red_depth,
+                                         bool unique) {
+    if (n == 0)
+        return 0;
+    size_type left_n = (n - 1) / 2;
+    link_type l = build_sorted(first, last, left_n, depth + 1, red_depth,
+                               unique);
+    link_type x;
+    try {
+        x = create_node(*first);
+    } catch (...) {
+        if (l)
+            erase_aux(l);
+        throw;
+    }
+    FI prev = first;
+    ++first;
+    if (unique)
+        while (first != last && !key_compare(KoV()(*prev), KoV()(*first)))
+            ++first;
+    x->left = l;
+    x->right = 0;
+    if (l)
+        l->set_parent(x);
+    try {
+        x->right = build_sorted(first, last, n - 1 - left_n, depth + 1,
+                                red_depth, unique);
+    } catch (...) {
+        erase_aux(x);
+        throw;
+    }
+    if (x->right)
+        x->right->set_parent(x);
+    size_ops::set(x, n);
+    x->set_color(depth == red_depth && depth != 0 ? red_node : black_node);
+    return x;
+}
+
+template <typename K, typename V, typename KoV, typename Cmp, bool R>
+template <typename FI>
+void rb_tree<K, V, KoV, Cmp, R>::assign_sorted(FI first, FI last, size_type n,
+                                               bool unique) {
+    size_type red_depth = 0;
+    while ((size_type(2) << red_depth) <= n)
+        ++red_depth;
+    root() = build_sorted(first, last, n, 0, red_depth, unique);
+    root()->set_parent(header);
+    leftmost() = minimum(root());
+    rightmost() = maximum(root());
+    node_count = n;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::node_type
+rb_tree<Key, Value, KeyOfValue, Compare, R>::extract(iterator position) {
+    link_type y = (link_type)rb_tree_rebalance_for_erase<R>(
+        position.node, root(), header->left, header->right);
+    --node_count;
+    return node_type(y);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::node_type
+rb_tree<Key, Value, KeyOfValue, Compare, R>::extract(const Key& k) {
+    iterator position = find(k);
+    return position == end() ? node_type() : extract(position);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, R>::iterator, bool>
+rb_tree<Key, Value, KeyOfValue, Compare, R>::insert_unique(node_type&& nh) {
+    if (nh.empty())
+        return std::pair<iterator, bool>(end(), false);
+    const Key& k = key(nh.get());
+    link_type y = header;
+    link_type x = root();
+    bool comp = true;
+    while (x != 0) {
+        y = x;
+        comp = key_compare(k, key(x));
+        x = comp ? left(x) : right(x);
+    }
+    iterator j = iterator(y);
+    if (comp) {
+        if (j == begin()) {
+            iterator result = link_aux(x, y, nh.get());
+            nh.release();
+            return std::pair<iterator, bool>(result, true);
+        }
+        --j;
+    }
+    if (key_compare(key(j.node), k)) {
+        iterator result = link_aux(x, y, nh.get());
+        nh.release();
+        return std::pair<iterator, bool>(result, true);
+    }
+    return std::pair<iterator, bool>(j, false);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, R>::insert_equal(node_type&& nh) {
+    if (nh.empty())
+        return end();
+    const Key& k = key(nh.get());
+    link_type y = header;
+    link_type x = root();
+    while (x != 0) {
+        y = x;
+        x = key_compare(k, key(x)) ? left(x) : right(x);
+    }
+    iterator result = link_aux(x, y, nh.get());
+    nh.release();
+    return result;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+inline void rb_tree<Key, Value, KeyOfValue, Compare, R>::erase(
+    iterator position) {
+    link_type y = (link_type)rb_tree_rebalance_for_erase<R>(
+        position.node, root(), header->left, header->right);
     destroy_node(y);
     --node_count;
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-typename rb_tree<Key, Value, KeyOfValue, Compare>::size_type
-rb_tree<Key, Value, KeyOfValue, Compare>::erase(const Key& x) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, R>::erase(const Key& x) {
     std::pair<iterator, iterator> p = equal_range(x);
     size_type n = 0;
     distance(p.first, p.second, n);
@@ -684,11 +1242,11 @@ rb_tree<Key, Value, KeyOfValue, Compare>::erase(const Key& x) {
     return n;
 }
 
-template <typename K, typename V, typename KeyOfValue, typename Compare>
-typename rb_tree<K, V, KeyOfValue, Compare>::link_type
-rb_tree<K, V, KeyOfValue, Compare>::copy_aux(link_type x, link_type p) {
+template <typename K, typename V, typename KeyOfValue, typename Compare, bool R>
+typename rb_tree<K, V, KeyOfValue, Compare, R>::link_type
+rb_tree<K, V, KeyOfValue, Compare, R>::copy_aux(link_type x, link_type p) {
     link_type top = clone_node(x);
-    top->parent = p;
+    top->set_parent(p);
     try {
         if (x->right)
             top->right = copy_aux(right(x), top);
@@ -698,7 +1256,7 @@ rb_tree<K, V, KeyOfValue, Compare>::copy_aux(link_type x, link_type p) {
         while (x != 0) {
             link_type y = clone_node(x);
             p->left = y;
-            y->parent = p;
+            y->set_parent(p);
             if (x->right)
                 y->right = copy_aux(right(x), y);
             p = y;
@@ -711,19 +1269,306 @@ rb_tree<K, V, KeyOfValue, Compare>::copy_aux(link_type x, link_type p) {
     return top;
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-void rb_tree<Key, Value, KeyOfValue, Compare>::erase_aux(link_type x) {
+// 返回释放的节点个数
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, R>::erase_aux(link_type x) {
+    size_type n = 0;
     while (x != 0) {
-        erase_aux(right(x));
+        n += erase_aux(right(x)) + 1;
         link_type y = left(x);
         destroy_node(x);
         x = y;
     }
+    return n;
+}
+
+// 以 x 为根、n 为元素个数重新设置头节点，各节点的 size 已经正确
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+void rb_tree<Key, Value, KeyOfValue, Compare, R>::reset_root(link_type x,
+                                                            size_type n) {
+    root() = x;
+    node_count = n;
+    if (x) {
+        x->set_parent(header);
+        x->set_color(black_node);
+        leftmost() = minimum(x);
+        rightmost() = maximum(x);
+    } else {
+        leftmost() = header;
+        rightmost() = header;
+    }
+}
+
+// 把子树 x 拆成键小于 k 的 l、键等于 k 的节点 m（可能为空）和键大于 k 的 r
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+void rb_tree<Key, Value, KeyOfValue, Compare, R>::split_aux(
+    link_type x, size_type hx, const Key& k, link_type& l, size_type& hl,
+    link_type& m, link_type& r, size_type& hr) {
+    if (x == 0) {
+        l = m = r = 0;
+        hl = hr = 0;
+        return;
+    }
+    link_type xl = left(x);
+    link_type xr = right(x);
+    size_type hc = child_height(x, hx);
+    if (key_compare(k, key(x))) {
+        split_aux(xl, hc, k, l, hl, m, r, hr);
+        r = rb_tree_join<R>(r, hr, x, xr, hc, hr);
+    } else if (key_compare(key(x), k)) {
+        split_aux(xr, hc, k, l, hl, m, r, hr);
+        l = rb_tree_join<R>(xl, hc, x, l, hl, hl);
+    } else {
+        l = xl;
+        m = x;
+        r = xr;
+        hl = hr = hc;
+    }
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-void rb_tree<Key, Value, KeyOfValue, Compare>::erase(iterator first,
-                                                     iterator last) {
+// 摘下子树 x 中的最大节点 last，其余部分为 rest
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+void rb_tree<Key, Value, KeyOfValue, Compare, R>::split_last(
+    link_type x, size_type hx, link_type& rest, size_type& hrest,
+    link_type& last) {
+    size_type hc = child_height(x, hx);
+    if (right(x) == 0) {
+        rest = left(x);
+        hrest = hc;
+        if (rest)
+            rest->set_parent(0);
+        last = x;
+    } else {
+        link_type xl = left(x);
+        split_last(right(x), hc, rest, hrest, last);
+        rest = rb_tree_join<R>(xl, hc, x, rest, hrest, hrest);
+    }
+}
+
+// 没有分界节点时借用 l 的最大节点
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, R>::join2(link_type l, size_type hl,
+                                                   link_type r, size_type hr,
+                                                   size_type& h) {
+    if (l == 0) {
+        h = hr;
+        return r;
+    }
+    if (r == 0) {
+        h = hl;
+        return l;
+    }
+    link_type rest, last;
+    size_type hrest;
+    split_last(l, hl, rest, hrest, last);
+    return rb_tree_join<R>(rest, hrest, last, r, hr, h);
+}
+
+// 以下三个函数把释放的节点个数累加到 dropped，调用者据此算出结果的元素个数
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, R>::union_aux(
+    link_type a, size_type ha, link_type b, size_type hb, size_type& h,
+    size_type& dropped) {
+    if (a == 0) {
+        h = hb;
+        return b;
+    }
+    if (b == 0) {
+        h = ha;
+        return a;
+    }
+    link_type al = left(a);
+    link_type ar = right(a);
+    size_type hc = child_height(a, ha);
+    link_type l, m, r;
+    size_type hl, hr;
+    split_aux(b, hb, key(a), l, hl, m, r, hr);
+    if (m) {
+        destroy_node(m);
+        ++dropped;
+    }
+    l = union_aux(al, hc, l, hl, hl, dropped);
+    r = union_aux(ar, hc, r, hr, hr, dropped);
+    return rb_tree_join<R>(l, hl, a, r, hr, h);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, R>::intersect_aux(
+    link_type a, size_type ha, link_type b, size_type hb, size_type& h,
+    size_type& dropped) {
+    if (a == 0 || b == 0) {
+        dropped += erase_aux(a) + erase_aux(b);
+        h = 0;
+        return 0;
+    }
+    link_type al = left(a);
+    link_type ar = right(a);
+    size_type hc = child_height(a, ha);
+    link_type l, m, r;
+    size_type hl, hr;
+    split_aux(b, hb, key(a), l, hl, m, r, hr);
+    l = intersect_aux(al, hc, l, hl, hl, dropped);
+    r = intersect_aux(ar, hc, r, hr, hr, dropped);
+    ++dropped;
+    if (m) {
+        destroy_node(m);
+        return rb_tree_join<R>(l, hl, a, r, hr, h);
+    }
+    destroy_node(a);
+    return join2(l, hl, r, hr, h);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, R>::subtract_aux(
+    link_type a, size_type ha, link_type b, size_type hb, size_type& h,
+    size_type& dropped) {
+    if (a == 0 || b == 0) {
+        dropped += erase_aux(b);
+        h = ha;
+        return a;
+    }
+    link_type l, m, r;
+    size_type hl, hr;
+    // 带子树大小时总是沿较小的树递归，用它的节点去拆分较大的树；
+    // 不带时两边都当作 0，总是拆分 a，复杂度的界不变，只是常数大一些
+    if (size_ops::size(a) < size_ops::size(b)) {
+        link_type al = left(a);
+        link_type ar = right(a);
+        size_type hc = child_height(a, ha);
+        split_aux(b, hb, key(a), l, hl, m, r, hr);
+        l = subtract_aux(al, hc, l, hl, hl, dropped);
+        r = subtract_aux(ar, hc, r, hr, hr, dropped);
+        if (m == 0)
+            return rb_tree_join<R>(l, hl, a, r, hr, h);
+        destroy_node(m);
+        destroy_node(a);
+        dropped += 2;
+        return join2(l, hl, r, hr, h);
+    }
+    link_type bl = left(b);
+    link_type br = right(b);
+    size_type hc = child_height(b, hb);
+    split_aux(a, ha, key(b), l, hl, m, r, hr);
+    destroy_node(b);
+    ++dropped;
+    if (m) {
+        destroy_node(m);
+        ++dropped;
+    }
+    l = subtract_aux(l, hl, bl, hc, hl, dropped);
+    r = subtract_aux(r, hr, br, hc, hr, dropped);
+    return join2(l, hl, r, hr, h);
+}
+
+// 整棵树的黑高只在入口处数一次
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+void rb_tree<Key, Value, KeyOfValue, Compare, R>::join(rb_tree& x) {
+    if (this == &x)
+        return;
+    link_type r = x.root();
+    size_type n = node_count + x.node_count;
+    size_type h;
+    x.reset_root(0, 0);
+    reset_root(join2(root(), rb_tree_black_height(root()), r,
+                     rb_tree_black_height(r), h),
+               n);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+void rb_tree<Key, Value, KeyOfValue, Compare, R>::split(const Key& k,
+                                                        rb_tree& x) {
+    link_type l, m, r;
+    size_type hl, hr;
+    size_type n = node_count;
+    split_aux(root(), rb_tree_black_height(root()), k, l, hl, m, r, hr);
+    if (m)
+        r = rb_tree_join<R>((link_type)0, 0, m, r, hr, hr);
+    size_type nr = R ? size_ops::size(r) : count_aux(r);
+    reset_root(l, n - nr);
+    x.reset_root(r, nr);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+void rb_tree<Key, Value, KeyOfValue, Compare, R>::unite(rb_tree& x) {
+    if (this == &x)
+        return;
+    // 较小的树逐个节点拆分较大的树，递归次数由较小的树决定
+    link_type a = root();
+    link_type b = x.root();
+    size_type na = node_count;
+    size_type nb = x.node_count;
+    size_type ha = rb_tree_black_height(a);
+    size_type hb = rb_tree_black_height(b);
+    size_type h, dropped = 0;
+    if (a) a->set_parent(0);
+    if (b) b->set_parent(0);
+    x.reset_root(0, 0);
+    link_type t = na <= nb ? union_aux(a, ha, b, hb, h, dropped)
+                           : union_aux(b, hb, a, ha, h, dropped);
+    reset_root(t, na + nb - dropped);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+void rb_tree<Key, Value, KeyOfValue, Compare, R>::intersect(rb_tree& x) {
+    if (this == &x)
+        return;
+    link_type a = root();
+    link_type b = x.root();
+    size_type na = node_count;
+    size_type nb = x.node_count;
+    size_type ha = rb_tree_black_height(a);
+    size_type hb = rb_tree_black_height(b);
+    size_type h, dropped = 0;
+    if (a) a->set_parent(0);
+    if (b) b->set_parent(0);
+    x.reset_root(0, 0);
+    link_type t = na <= nb ? intersect_aux(a, ha, b, hb, h, dropped)
+                           : intersect_aux(b, hb, a, ha, h, dropped);
+    reset_root(t, na + nb - dropped);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+void rb_tree<Key, Value, KeyOfValue, Compare, R>::subtract(rb_tree& x) {
+    if (this == &x) {
+        clear();
+        return;
+    }
+    link_type a = root();
+    link_type b = x.root();
+    size_type na = node_count;
+    size_type nb = x.node_count;
+    size_type ha = rb_tree_black_height(a);
+    size_type hb = rb_tree_black_height(b);
+    size_type h, dropped = 0;
+    if (a) a->set_parent(0);
+    if (b) b->set_parent(0);
+    x.reset_root(0, 0);
+    link_type t = subtract_aux(a, ha, b, hb, h, dropped);
+    reset_root(t, na + nb - dropped);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+void rb_tree<Key, Value, KeyOfValue, Compare, R>::erase(iterator first,
+                                                        iterator last) {
     if (first == begin() && last == end())
         clear();
     else
@@ -731,16 +1576,18 @@ void rb_tree<Key, Value, KeyOfValue, Compare>::erase(iterator first,
             erase(first++);
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-void rb_tree<Key, Value, KeyOfValue, Compare>::erase(const Key* first,
-                                                     const Key* last) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+void rb_tree<Key, Value, KeyOfValue, Compare, R>::erase(const Key* first,
+                                                        const Key* last) {
     while (first != last)
         erase(*first++);
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-typename rb_tree<Key, Value, KeyOfValue, Compare>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare>::find(const Key& k) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, R>::find(const Key& k) {
     link_type y = header;
     link_type x = root();
 
@@ -754,9 +1601,10 @@ rb_tree<Key, Value, KeyOfValue, Compare>::find(const Key& k) {
     return (j == end() || key_compare(k, key(j.node))) ? end() : j;
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-typename rb_tree<Key, Value, KeyOfValue, Compare>::const_iterator
-rb_tree<Key, Value, KeyOfValue, Compare>::find(const Key& k) const {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::const_iterator
+rb_tree<Key, Value, KeyOfValue, Compare, R>::find(const Key& k) const {
     link_type y = header;
     link_type x = root();
 
@@ -770,18 +1618,20 @@ rb_tree<Key, Value, KeyOfValue, Compare>::find(const Key& k) const {
     return (j == end() || key_compare(k, key(j.node))) ? end() : j;
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-typename rb_tree<Key, Value, KeyOfValue, Compare>::size_type
-rb_tree<Key, Value, KeyOfValue, Compare>::count(const Key& k) const {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, R>::count(const Key& k) const {
     std::pair<const_iterator, const_iterator> p = equal_range(k);
     size_type n = 0;
     distance(p.first, p.second, n);
     return n;
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-typename rb_tree<Key, Value, KeyOfValue, Compare>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare>::lower_bound(const Key& k) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, R>::lower_bound(const Key& k) {
     link_type y = header;
     link_type x = root();
 
@@ -793,9 +1643,10 @@ rb_tree<Key, Value, KeyOfValue, Compare>::lower_bound(const Key& k) {
     return iterator(y);
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-typename rb_tree<Key, Value, KeyOfValue, Compare>::const_iterator
-rb_tree<Key, Value, KeyOfValue, Compare>::lower_bound(const Key& k) const {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::const_iterator
+rb_tree<Key, Value, KeyOfValue, Compare, R>::lower_bound(const Key& k) const {
     link_type y = header;
     link_type x = root();
 
@@ -807,9 +1658,10 @@ rb_tree<Key, Value, KeyOfValue, Compare>::lower_bound(const Key& k) const {
     return const_iterator(y);
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-typename rb_tree<Key, Value, KeyOfValue, Compare>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare>::upper_bound(const Key& k) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, R>::upper_bound(const Key& k) {
     link_type y = header;
     link_type x = root();
 
@@ -821,9 +1673,10 @@ rb_tree<Key, Value, KeyOfValue, Compare>::upper_bound(const Key& k) {
     return iterator(y);
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-typename rb_tree<Key, Value, KeyOfValue, Compare>::const_iterator
-rb_tree<Key, Value, KeyOfValue, Compare>::upper_bound(const Key& k) const {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::const_iterator
+rb_tree<Key, Value, KeyOfValue, Compare, R>::upper_bound(const Key& k) const {
     link_type y = header;
     link_type x = root();
 
@@ -835,36 +1688,75 @@ rb_tree<Key, Value, KeyOfValue, Compare>::upper_bound(const Key& k) const {
     return const_iterator(y);
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-inline std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare>::iterator,
-                 typename rb_tree<Key, Value, KeyOfValue, Compare>::iterator>
-rb_tree<Key, Value, KeyOfValue, Compare>::equal_range(const Key& k) {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+inline std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, R>::iterator,
+                 typename rb_tree<Key, Value, KeyOfValue, Compare, R>::iterator>
+rb_tree<Key, Value, KeyOfValue, Compare, R>::equal_range(const Key& k) {
     return std::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
 }
 
-template <typename Key, typename Value, typename KoV, typename Compare>
-inline std::pair<typename rb_tree<Key, Value, KoV, Compare>::const_iterator,
-                 typename rb_tree<Key, Value, KoV, Compare>::const_iterator>
-rb_tree<Key, Value, KoV, Compare>::equal_range(const Key& k) const {
+template <typename Key, typename Value, typename KoV, typename Compare, bool R>
+inline std::pair<typename rb_tree<Key, Value, KoV, Compare, R>::const_iterator,
+                 typename rb_tree<Key, Value, KoV, Compare, R>::const_iterator>
+rb_tree<Key, Value, KoV, Compare, R>::equal_range(const Key& k) const {
     return std::pair<const_iterator, const_iterator>(lower_bound(k),
                                                      upper_bound(k));
 }
 
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, R>::select(size_type k) const {
+    static_assert(R, "select requires an rb_tree with Ranked = true");
+    link_type x = root();
+    while (x != 0) {
+        size_type left_size = size_ops::size(left(x));
+        if (k < left_size)
+            x = left(x);
+        else if (k == left_size)
+            return iterator(x);
+        else {
+            k -= left_size + 1;
+            x = right(x);
+        }
+    }
+    return iterator(header);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool R>
+typename rb_tree<Key, Value, KeyOfValue, Compare, R>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, R>::rank(const Key& k) const {
+    static_assert(R, "rank requires an rb_tree with Ranked = true");
+    size_type result = 0;
+    link_type x = root();
+    while (x != 0)
+        if (!key_compare(key(x), k))
+            x = left(x);
+        else {
+            result += size_ops::size(left(x)) + 1;
+            x = right(x);
+        }
+    return result;
+}
+
 template <typename Value>
 inline int black_count(tree_node<Value>* node, tree_node<Value>* root) {
     if (node == 0)
         return 0;
     else {
-        int bc = node->color == black_node ? 1 : 0;
+        int bc = node->color() == black_node ? 1 : 0;
         if (node == root)
             return bc;
         else
-            return bc + black_count(node->parent, root);
+            return bc + black_count(node->parent(), root);
     }
 }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare>
-bool rb_tree<Key, Value, KeyOfValue, Compare>::rb_verify() const {
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Ranked>
+bool rb_tree<Key, Value, KeyOfValue, Compare, Ranked>::rb_verify() const {
     if (node_count == 0 || begin() == end())
         return node_count == 0 && begin() == end() && header->left == header &&
                header->right == header;
@@ -875,8 +1767,8 @@ bool rb_tree<Key, Value, KeyOfValue, Compare>::rb_verify() const {
         link_type L = left(x);
         link_type R = right(x);
 
-        if (x->color == red_node)
-            if ((L && L->color == red_node) || (R && R->color == red_node))
+        if (x->color() == red_node)
+            if ((L && L->color() == red_node) || (R && R->color() == red_node))
                 return false;
 
         if (L && key_compare(key(x), key(L)))
@@ -886,12 +1778,19 @@ bool rb_tree<Key, Value, KeyOfValue, Compare>::rb_verify() const {
 
         if (!L && !R && black_count(x, root()) != len)
             return false;
+
+        if (Ranked && size_ops::size(x) !=
+                          size_ops::size(L) + size_ops::size(R) + 1)
+            return false;
     }
 
     if (leftmost() != tree_node<Value>::minimum(root()))
         return false;
     if (rightmost() != tree_node<Value>::maximum(root()))
         return false;
+    if (Ranked ? size_ops::size(root()) != node_count
+               : count_aux(root()) != node_count)
+        return false;
 
     return true;
 }
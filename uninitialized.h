@@ -23,10 +23,10 @@ inline ForwardIterator uninitialized_copy_aux(InputIterator first,
     ForwardIterator cur = result;
     try {
         for (; first != last; ++first, ++cur)
-            construct(cur, *first);
+            mystl::construct(&*cur, *first);
         return cur;
     } catch (...) {
-        destroy(result, cur);
+        mystl::destroy(result, cur);
         throw;
     }
 }
@@ -57,10 +57,9 @@ inline void uninitialized_fill_aux(ForwardIterator first,
     ForwardIterator cur = first;
     try {
         for (; cur != last; ++cur)
-            construct(cur, value);
-        return cur;
+            mystl::construct(&*cur, value);
     } catch (...) {
-        destroy(first, cur);
+        mystl::destroy(first, cur);
         throw;
     }
 }
@@ -91,10 +90,10 @@ inline ForwardIterator uninitialized_fill_n_aux(ForwardIterator first,
     ForwardIterator cur = first;
     try {
         for (; n != 0; --n, ++cur)
-            construct(cur, value);
+            mystl::construct(&*cur, value);
         return cur;
     } catch (...) {
-        destroy(first, cur);
+        mystl::destroy(first, cur);
         throw;
     }
 }
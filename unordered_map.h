@@ -0,0 +1,147 @@
+#if !defined(MYSTL_UNORDERED_MAP_H_)
+#define MYSTL_UNORDERED_MAP_H_
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "swiss_table.h"
+
+namespace mystl {
+// 以开放寻址的 swiss_table 为底层容器，元素为 pair<const Key, T>
+// 插入可能使所有迭代器与元素的引用失效
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class unordered_map {
+public:
+    using key_type      = Key;
+    using mapped_type   = T;
+    using value_type    = std::pair<const Key, T>;
+    using hasher        = Hash;
+    using key_equal     = KeyEqual;
+
+private:
+    using rep_type = swiss_table<value_type, Key, std::_Select1st<value_type>,
+                                 Hash, KeyEqual>;
+    rep_type table;
+
+    template <typename K>
+    using enable_if_transparent = typename std::enable_if<
+        is_transparent<Hash>::value && is_transparent<KeyEqual>::value,
+        K>::type;
+
+public:
+    using pointer           = typename rep_type::pointer;
+    using const_pointer     = typename rep_type::const_pointer;
+    using reference         = typename rep_type::reference;
+    using const_reference   = typename rep_type::const_reference;
+    using iterator          = typename rep_type::iterator;
+    using const_iterator    = typename rep_type::const_iterator;
+    using difference_type   = typename rep_type::difference_type;
+    using size_type         = typename rep_type::size_type;
+
+    // 构造函数
+    unordered_map() : table(Hash(), KeyEqual()) {}
+    explicit unordered_map(size_type n, const Hash& hf = Hash(),
+                           const KeyEqual& eql = KeyEqual())
+        : table(hf, eql) {
+        table.reserve(n);
+    }
+    template <typename InputIterator>
+    unordered_map(InputIterator first, InputIterator last)
+        : table(Hash(), KeyEqual()) {
+        table.insert_unique(first, last);
+    }
+    unordered_map(std::initializer_list<value_type> rhs)
+        : table(Hash(), KeyEqual()) {
+        table.reserve(rhs.size());
+        table.insert_unique(rhs.begin(), rhs.end());
+    }
+
+    hasher          hash_function() const { return table.hash_function(); }
+    key_equal       key_eq()        const { return table.key_eq(); }
+    iterator        begin()               { return table.begin(); }
+    const_iterator  begin()         const { return table.begin(); }
+    iterator        end()                 { return table.end(); }
+    const_iterator  end()           const { return table.end(); }
+    bool            empty()         const { return table.empty(); }
+    size_type       size()          const { return table.size(); }
+    size_type       max_size()      const { return table.max_size(); }
+    size_type       bucket_count()  const { return table.bucket_count(); }
+    float           load_factor()   const { return table.load_factor(); }
+    float           max_load_factor() const { return table.max_load_factor(); }
+    void            reserve(size_type n) { table.reserve(n); }
+    void            rehash(size_type n) { table.rehash(n); }
+    void            swap(unordered_map& x) { table.swap(x.table); }
+
+    T& operator[](const key_type& k) { return try_emplace(k).first->second; }
+    T& at(const key_type& k) {
+        iterator i = find(k);
+        if (i == end())
+            throw std::out_of_range("unordered_map::at");
+        return i->second;
+    }
+    const T& at(const key_type& k) const {
+        const_iterator i = find(k);
+        if (i == end())
+            throw std::out_of_range("unordered_map::at");
+        return i->second;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& x) {
+        return table.insert_unique(x);
+    }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        table.insert_unique(first, last);
+    }
+
+    // 只查找一次，键已存在时不构造 T
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args) {
+        return table.find_or_insert(k, [&](value_type* p) {
+            new (p) value_type(std::piecewise_construct,
+                               std::forward_as_tuple(k),
+                               std::forward_as_tuple(
+                                   std::forward<Args>(args)...));
+        });
+    }
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj) {
+        std::pair<iterator, bool> p = try_emplace(k, std::forward<M>(obj));
+        if (!p.second)
+            p.first->second = std::forward<M>(obj);
+        return p;
+    }
+
+    void erase(iterator position) { table.erase(position); }
+    size_type erase(const key_type& x) { return table.erase(x); }
+    void clear() { table.clear(); }
+
+    iterator find(const key_type& x) { return table.find(x); }
+    const_iterator find(const key_type& x) const { return table.find(x); }
+    size_type count(const key_type& x) const { return table.count(x); }
+    template <typename K, typename = enable_if_transparent<K>>
+    iterator find(const K& x) {
+        return table.find(x);
+    }
+    template <typename K, typename = enable_if_transparent<K>>
+    const_iterator find(const K& x) const {
+        return table.find(x);
+    }
+    template <typename K, typename = enable_if_transparent<K>>
+    size_type count(const K& x) const {
+        return table.count(x);
+    }
+};  // class unordered_map
+
+template <typename Key, typename T, typename Hash, typename KeyEqual>
+inline void swap(unordered_map<Key, T, Hash, KeyEqual>& lhs,
+                 unordered_map<Key, T, Hash, KeyEqual>& rhs) {
+    lhs.swap(rhs);
+}
+}  // namespace mystl
+
+#endif  // MYSTL_UNORDERED_MAP_H_
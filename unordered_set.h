@@ -0,0 +1,106 @@
+#if !defined(MYSTL_UNORDERED_SET_H_)
+#define MYSTL_UNORDERED_SET_H_
+
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include "swiss_table.h"
+
+namespace mystl {
+// 以开放寻址的 swiss_table 为底层容器，插入可能使所有迭代器失效
+// Hash 与 KeyEqual 都声明了 is_transparent 时，find/count 可以直接用其他类型的键查找
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class unordered_set {
+private:
+    using rep_type =
+        swiss_table<Key, Key, std::_Identity<Key>, Hash, KeyEqual>;
+    rep_type table;
+
+    template <typename K>
+    using enable_if_transparent = typename std::enable_if<
+        is_transparent<Hash>::value && is_transparent<KeyEqual>::value,
+        K>::type;
+
+public:
+    using key_type      = Key;
+    using value_type    = Key;
+    using hasher        = Hash;
+    using key_equal     = KeyEqual;
+
+    using pointer           = typename rep_type::const_pointer;
+    using const_pointer     = typename rep_type::const_pointer;
+    using reference         = typename rep_type::const_reference;
+    using const_reference   = typename rep_type::const_reference;
+    using iterator          = typename rep_type::const_iterator;
+    using const_iterator    = typename rep_type::const_iterator;
+    using difference_type   = typename rep_type::difference_type;
+    using size_type         = typename rep_type::size_type;
+
+    // 构造函数
+    unordered_set() : table(Hash(), KeyEqual()) {}
+    explicit unordered_set(size_type n, const Hash& hf = Hash(),
+                           const KeyEqual& eql = KeyEqual())
+        : table(hf, eql) {
+        table.reserve(n);
+    }
+    template <typename InputIterator>
+    unordered_set(InputIterator first, InputIterator last)
+        : table(Hash(), KeyEqual()) {
+        table.insert_unique(first, last);
+    }
+    unordered_set(std::initializer_list<Key> rhs)
+        : table(Hash(), KeyEqual()) {
+        table.reserve(rhs.size());
+        table.insert_unique(rhs.begin(), rhs.end());
+    }
+
+    hasher          hash_function() const { return table.hash_function(); }
+    key_equal       key_eq()        const { return table.key_eq(); }
+    iterator        begin()         const { return table.begin(); }
+    iterator        end()           const { return table.end(); }
+    bool            empty()         const { return table.empty(); }
+    size_type       size()          const { return table.size(); }
+    size_type       max_size()      const { return table.max_size(); }
+    size_type       bucket_count()  const { return table.bucket_count(); }
+    float           load_factor()   const { return table.load_factor(); }
+    float           max_load_factor() const { return table.max_load_factor(); }
+    void            reserve(size_type n) { table.reserve(n); }
+    void            rehash(size_type n) { table.rehash(n); }
+    void            swap(unordered_set& x) { table.swap(x.table); }
+
+    std::pair<iterator, bool> insert(const value_type& x) {
+        return table.insert_unique(x);
+    }
+    std::pair<iterator, bool> insert(value_type&& x) {
+        return table.insert_unique(std::move(x));
+    }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        table.insert_unique(first, last);
+    }
+
+    void erase(iterator position) { table.erase(position); }
+    size_type erase(const key_type& x) { return table.erase(x); }
+    void clear() { table.clear(); }
+
+    iterator find(const key_type& x) const { return table.find(x); }
+    size_type count(const key_type& x) const { return table.count(x); }
+    template <typename K, typename = enable_if_transparent<K>>
+    iterator find(const K& x) const {
+        return table.find(x);
+    }
+    template <typename K, typename = enable_if_transparent<K>>
+    size_type count(const K& x) const {
+        return table.count(x);
+    }
+};  // class unordered_set
+
+template <typename Key, typename Hash, typename KeyEqual>
+inline void swap(unordered_set<Key, Hash, KeyEqual>& lhs,
+                 unordered_set<Key, Hash, KeyEqual>& rhs) {
+    lhs.swap(rhs);
+}
+}  // namespace mystl
+
+#endif  // MYSTL_UNORDERED_SET_H_
@@ -0,0 +1,396 @@
+#if !defined(MYSTL_UNROLLED_LIST_H_)
+#define MYSTL_UNROLLED_LIST_H_
+
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include "iterator.h"
+#include "memory.h"
+
+/* 本头文件实现了展开链表 unrolled_list
+ * 每个节点保存一小段连续的元素，节点大小约为两个缓存行，遍历时每个节点只有一次缓存未命中
+ * 节点满时分裂为两半，节点过空时与后继合并；整条链表的 splice 仍然是 O(1) 的指针操作
+ * 分裂、合并与节点内挪位都要逐个搬移元素，搬到一半失败时无法复原：
+ * 移动构造为 noexcept 时（如 std::string）用移动构造搬移，否则退回复制构造，
+ * 这种情况下要求 T 的复制构造函数不抛出异常 */
+namespace mystl {
+
+// 每个节点可容纳的元素个数，使节点总大小约为 128 字节，至少为 4
+inline constexpr size_t unrolled_node_capacity(size_t sz) {
+    return (128 - 3 * sizeof(void*)) / sz < 4 ? 4 : (128 - 3 * sizeof(void*)) / sz;
+}
+
+template <typename T>
+struct unrolled_list_node {
+    static constexpr size_t capacity = unrolled_node_capacity(sizeof(T));
+
+    unrolled_list_node<T>* next;
+    unrolled_list_node<T>* prev;
+    size_t count;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage[capacity];
+
+    T* data() { return reinterpret_cast<T*>(storage); }
+};
+
+template <typename T, typename Ref, typename Ptr>
+struct unrolled_list_iterator {
+    using iterator          = unrolled_list_iterator<T, T&, T*>;
+    using const_iterator    = unrolled_list_iterator<T, const T&, const T*>;
+    using self              = unrolled_list_iterator<T, Ref, Ptr>;
+
+    using iterator_category = bidirectional_iterator_tag;
+    using value_type        = T;
+    using pointer           = Ptr;
+    using reference         = Ref;
+    using difference_type   = ptrdiff_t;
+    using size_type         = size_t;
+
+    using link_type         = unrolled_list_node<T>*;
+
+    // 所在节点以及在节点内的下标，end() 为头节点下标 0
+    link_type node;
+    size_type index;
+
+    unrolled_list_iterator(link_type x, size_type i) : node(x), index(i) {}
+    unrolled_list_iterator() {}
+    // 只接受 iterator，模板构造函数不算拷贝构造，拷贝仍由编译器生成
+    template <typename Iter, typename = typename std::enable_if<
+                                 std::is_same<Iter, iterator>::value>::type>
+    unrolled_list_iterator(const Iter& x) : node(x.node), index(x.index) {}
+
+    bool operator==(const self& rhs) const {
+        return node == rhs.node && index == rhs.index;
+    }
+    bool operator!=(const self& rhs) const { return !(*this == rhs); }
+    reference operator*() const { return node->data()[index]; }
+    pointer operator->() const { return &(operator*()); }
+    self& operator++() {
+        if (++index == node->count) {
+            node = node->next;
+            index = 0;
+        }
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator--() {
+        if (index == 0) {
+            node = node->prev;
+            index = node->count;
+        }
+        --index;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+};  // end struct unrolled_list_iterator
+
+template <typename T, typename Alloc = mystl::alloc<T>>
+class unrolled_list {
+   public:
+    using value_type        = T;
+    using pointer           = T*;
+    using const_pointer     = const T*;
+    using reference         = T&;
+    using const_reference   = const T&;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+    using link_type         = unrolled_list_node<T>*;
+    using iterator          = unrolled_list_iterator<T, T&, T*>;
+    using const_iterator    = unrolled_list_iterator<T, const T&, const T*>;
+
+   protected:
+    using node_alloc = typename Alloc::template rebind<unrolled_list_node<T>>::other;
+    static constexpr size_type node_capacity = unrolled_list_node<T>::capacity;
+
+    link_type node;         // 头节点，不保存元素
+    size_type node_count;   // 元素个数
+
+    /* 内部辅助函数 */
+    link_type create_node(link_type pos);
+    void destroy_node(link_type ptr);
+    void empty_init();
+    void fill_init(size_type n, const T& value);
+    template <typename InputIterator>
+    void range_init(InputIterator first, InputIterator last);
+    static void relocate(T* dst, T* src, size_type n);
+    link_type split_node(link_type x, size_type at);
+    iterator normalize(link_type x, size_type i) const {
+        return i == x->count ? iterator(x->next, 0) : iterator(x, i);
+    }
+
+   public:
+    /* 各种构造拷贝析构函数 */
+    unrolled_list() { empty_init(); }
+    unrolled_list(size_type n, const T& value) { fill_init(n, value); }
+    unrolled_list(int n, const T& value) { fill_init(size_type(n), value); }
+    unrolled_list(long n, const T& value) { fill_init(size_type(n), value); }
+    explicit unrolled_list(size_type n) { fill_init(n, T()); }
+    template <typename InputIterator>
+    unrolled_list(InputIterator first, InputIterator last) {
+        range_init(first, last);
+    }
+    unrolled_list(const unrolled_list& rhs) { range_init(rhs.begin(), rhs.end()); }
+    unrolled_list(std::initializer_list<T> rhs) { range_init(rhs.begin(), rhs.end()); }
+    unrolled_list& operator=(const unrolled_list& rhs) {
+        if (&rhs != this) {
+            unrolled_list tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+    ~unrolled_list() {
+        clear();
+        node_alloc::deallocate(node);
+    }
+
+    /* 迭代器相关操作 */
+    iterator begin() noexcept { return iterator(node->next, 0); }
+    const_iterator begin() const noexcept { return const_iterator(node->next, 0); }
+    iterator end() noexcept { return iterator(node, 0); }
+    const_iterator end() const noexcept { return const_iterator(node, 0); }
+
+    /* 容量相关操作 */
+    bool empty() const noexcept { return node_count == 0; }
+    size_type size() const noexcept { return node_count; }
+    size_type max_size() const noexcept { return size_type(-1); }
+
+    /* 取值相关操作 */
+    reference front() { return node->next->data()[0]; }
+    const_reference front() const { return node->next->data()[0]; }
+    reference back() { return node->prev->data()[node->prev->count - 1]; }
+    const_reference back() const { return node->prev->data()[node->prev->count - 1]; }
+
+    /* 修改链表操作 */
+    void swap(unrolled_list& rhs) {
+        std::swap(node, rhs.node);
+        std::swap(node_count, rhs.node_count);
+    }
+    iterator insert(iterator pos, const T& value);
+    void push_front(const T& value) { insert(begin(), value); }
+    void push_back(const T& value) { insert(end(), value); }
+    iterator erase(iterator pos);
+    iterator erase(iterator first, iterator last) {
+        // 逐个删除时节点可能合并，故而用剩余个数控制循环
+        size_type n = mystl::distance(first, last);
+        for (; n > 0; --n)
+            first = erase(first);
+        return first;
+    }
+    void clear();
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(iterator(node->prev, node->prev->count - 1)); }
+    void splice(iterator pos, unrolled_list& x);
+};  // class unrolled_list
+
+/* unrolled_list 类的辅助函数实现 */
+
+// 分配一个空节点并链接到 pos 之前
+template <typename T, typename Alloc>
+typename unrolled_list<T, Alloc>::link_type unrolled_list<T, Alloc>::create_node(
+    link_type pos) {
+    link_type x = node_alloc::allocate();
+    x->count = 0;
+    x->next = pos;
+    x->prev = pos->prev;
+    pos->prev->next = x;
+    pos->prev = x;
+    return x;
+}
+
+// 断开并释放一个节点，节点内元素应已析构
+template <typename T, typename Alloc>
+void unrolled_list<T, Alloc>::destroy_node(link_type ptr) {
+    ptr->prev->next = ptr->next;
+    ptr->next->prev = ptr->prev;
+    node_alloc::deallocate(ptr);
+}
+
+template <typename T, typename Alloc>
+void unrolled_list<T, Alloc>::empty_init() {
+    node = node_alloc::allocate();
+    node->next = node;
+    node->prev = node;
+    node->count = 0;
+    node_count = 0;
+}
+
+template <typename T, typename Alloc>
+void unrolled_list<T, Alloc>::fill_init(size_type n, const T& value) {
+    empty_init();
+    try {
+        for (; n > 0; --n)
+            push_back(value);
+    } catch (...) {
+        clear();
+        node_alloc::deallocate(node);
+        throw;
+    }
+}
+
+template <typename T, typename Alloc>
+template <typename InputIterator>
+void unrolled_list<T, Alloc>::range_init(InputIterator first, InputIterator last) {
+    empty_init();
+    try {
+        for (; first != last; ++first)
+            push_back(*first);
+    } catch (...) {
+        clear();
+        node_alloc::deallocate(node);
+        throw;
+    }
+}
+
+// 把 n 个元素从 src 搬到 dst，dst 在 src 之前时从前往后搬，否则从后往前搬
+// 依赖文件开头的要求不会抛出异常，insert 失败时也靠它把元素搬回原位
+template <typename T, typename Alloc>
+void unrolled_list<T, Alloc>::relocate(T* dst, T* src, size_type n) {
+    if (dst < src) {
+        for (size_type i = 0; i != n; ++i) {
+            new (dst + i) T(std::move_if_noexcept(src[i]));
+            mystl::destroy(src + i);
+        }
+    } else {
+        for (size_type i = n; i != 0; --i) {
+            new (dst + i - 1) T(std::move_if_noexcept(src[i - 1]));
+            mystl::destroy(src + i - 1);
+        }
+    }
+}
+
+// 从下标 at 处把节点 x 一分为二，后半段移入新节点，返回新节点
+template <typename T, typename Alloc>
+typename unrolled_list<T, Alloc>::link_type unrolled_list<T, Alloc>::split_node(
+    link_type x, size_type at) {
+    link_type y = create_node(x->next);
+    relocate(y->data(), x->data() + at, x->count - at);
+    y->count = x->count - at;
+    x->count = at;
+    return y;
+}
+
+/* unrolled_list 类公开成员函数的实现 */
+
+template <typename T, typename Alloc>
+typename unrolled_list<T, Alloc>::iterator unrolled_list<T, Alloc>::insert(
+    iterator pos,
+    const T& value) {
+    // value 可能是本容器中的元素，分裂与搬移会把它挪走，先复制一份
+    T value_copy = value;
+    link_type x = pos.node;
+    size_type i = pos.index;
+    if (x == node) {
+        // 在末尾插入，优先放进最后一个节点
+        x = node->prev;
+        if (x == node || x->count == node_capacity)
+            x = create_node(node);
+        i = x->count;
+    } else if (i == 0 && x->prev != node && x->prev->count < node_capacity) {
+        // 插入点位于节点开头时，前一个节点的末尾同样可以容纳
+        x = x->prev;
+        i = x->count;
+    } else if (x->count == node_capacity) {
+        // 节点已满，对半分裂后再插入
+        size_type half = node_capacity / 2;
+        link_type y = split_node(x, half);
+        if (i > half) {
+            x = y;
+            i -= half;
+        }
+    }
+    T* p = x->data();
+    relocate(p + i + 1, p + i, x->count - i);
+    try {
+        mystl::construct(p + i, value_copy);
+    } catch (...) {
+        relocate(p + i, p + i + 1, x->count - i);
+        throw;
+    }
+    ++x->count;
+    ++node_count;
+    return iterator(x, i);
+}
+
+template <typename T, typename Alloc>
+typename unrolled_list<T, Alloc>::iterator unrolled_list<T, Alloc>::erase(
+    iterator pos) {
+    link_type x = pos.node;
+    size_type i = pos.index;
+    T* p = x->data();
+    mystl::destroy(p + i);
+    relocate(p + i, p + i + 1, x->count - i - 1);
+    --x->count;
+    --node_count;
+    if (x->count == 0) {
+        link_type next = x->next;
+        destroy_node(x);
+        return iterator(next, 0);
+    }
+    // 节点少于四分之一满且能装下后继节点的全部元素时，与后继合并
+    link_type next = x->next;
+    if (x->count < node_capacity / 4 && next != node &&
+        x->count + next->count <= node_capacity) {
+        relocate(p + x->count, next->data(), next->count);
+        x->count += next->count;
+        destroy_node(next);
+    }
+    return normalize(x, i);
+}
+
+template <typename T, typename Alloc>
+void unrolled_list<T, Alloc>::clear() {
+    link_type x = node->next;
+    while (x != node) {
+        link_type next = x->next;
+        mystl::destroy(x->data(), x->data() + x->count);
+        node_alloc::deallocate(x);
+        x = next;
+    }
+    node->next = node;
+    node->prev = node;
+    node_count = 0;
+}
+
+// 将 x 的全部节点整体接到 pos 之前，pos 不在节点开头时先把所在节点分裂
+template <typename T, typename Alloc>
+void unrolled_list<T, Alloc>::splice(iterator pos, unrolled_list& x) {
+    if (x.empty() || &x == this)
+        return;
+    link_type after = pos.node;
+    if (pos.index != 0)
+        after = split_node(pos.node, pos.index);
+    link_type first = x.node->next;
+    link_type last = x.node->prev;
+    x.node->next = x.node;
+    x.node->prev = x.node;
+    first->prev = after->prev;
+    after->prev->next = first;
+    last->next = after;
+    after->prev = last;
+    node_count += x.node_count;
+    x.node_count = 0;
+}
+
+template <typename T, typename Alloc>
+inline bool operator==(const unrolled_list<T, Alloc>& lhs,
+                       const unrolled_list<T, Alloc>& rhs) {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename Alloc>
+inline void swap(unrolled_list<T, Alloc>& lhs, unrolled_list<T, Alloc>& rhs) {
+    lhs.swap(rhs);
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_UNROLLED_LIST_H_
@@ -52,7 +52,7 @@ public:
     vector<T, Allocator>& operator=(const vector<T, Allocator>& vec);
     vector<T, Allocator>& operator=(std::initializer_list<T> rhs);
     ~vector() {
-        destroy(start, finish);
+        mystl::destroy(start, finish);
         deallocate();
     }
     // 迭代器相关操作
@@ -88,7 +88,7 @@ public:
 
     // 修改容器的操作
     void push_back(const T& value);
-    void pop_back() { --finish; destroy(finish); }
+    void pop_back() { --finish; mystl::destroy(finish); }
     void swap(vector<T, Allocator>& rhs);
     iterator insert(iterator position, const T& value);
     iterator insert(iterator position) { return insert(position, T());}
@@ -105,7 +105,7 @@ template <typename T, typename Alloc>
 void vector<T, Alloc>::fill_init(size_type n, const T& value) {
     start = Alloc::allocate(n);
     try {
-        uninitialized_fill_n(start, n, value);
+        mystl::uninitialized_fill_n(start, n, value);
         finish = start + n;
         end_of_storage = finish;
     }
@@ -120,7 +120,7 @@ void vector<T, Alloc>::copy_init(InputIterator first, InputIterator last) {
     size_type n = last - first;
     start = Alloc::allocate(n);
     try {
-        uninitialized_copy(first, last, start);
+        mystl::uninitialized_copy(first, last, start);
         finish = start + n;
         end_of_storage = finish;
     }
@@ -133,7 +133,7 @@ void vector<T, Alloc>::copy_init(InputIterator first, InputIterator last) {
 template <typename T, typename Alloc>
 void vector<T, Alloc>::insert_aux(iterator position, const T& value) {
     if (finish != end_of_storage) {
-        construct(finish, *(finish - 1));
+        mystl::construct(finish, *(finish - 1));
         ++finish;
         std::copy_backward(position, finish - 2, finish - 1);
         *position = value;
@@ -144,16 +144,16 @@ void vector<T, Alloc>::insert_aux(iterator position, const T& value) {
         iterator new_start = Alloc::allocate(new_size);
         iterator new_finish = new_start;
         try {
-            new_finish = uninitialized_copy(start, position, new_start);
-            construct(new_finish++, value);
-            new_finish = uninitialized_copy(position, finish, new_finish);
+            new_finish = mystl::uninitialized_copy(start, position, new_start);
+            mystl::construct(new_finish++, value);
+            new_finish = mystl::uninitialized_copy(position, finish, new_finish);
         }
         catch(...) {
-            destroy(new_start, new_finish);
+            mystl::destroy(new_start, new_finish);
             Alloc::deallocate(new_start, new_size);
             throw;
         }
-        destroy(start, finish);
+        mystl::destroy(start, finish);
         deallocate();
         start = new_start;
         finish = new_finish;
@@ -169,18 +169,18 @@ vector<T, Alloc>& vector<T, Alloc>::operator=(const vector<T, Alloc>& vec) {
         size_type new_size = vec.size();
         if (new_size > capacity()) {
             iterator new_start = Alloc::allocate(new_size);
-            end_of_storage = uninitialized_copy(vec.begin(), vec.end(), new_start);
-            destroy(start, finish);
+            end_of_storage = mystl::uninitialized_copy(vec.begin(), vec.end(), new_start);
+            mystl::destroy(start, finish);
             deallocate();
             start = new_start;
         }
         else if(new_size < size()) {
             iterator iter = std::copy(vec.begin(), vec.end(), start);
-            destroy(iter, finish);
+            mystl::destroy(iter, finish);
         }
         else {
             std::copy(vec.begin(), vec.begin() + size(), start);
-            uninitialized_copy(vec.begin() + size(), vec.end(), finish);
+            mystl::uninitialized_copy(vec.begin() + size(), vec.end(), finish);
         }
         finish = start + new_size;
     }
@@ -197,7 +197,7 @@ vector<T, Alloc>& vector<T, Alloc>::operator=(std::initializer_list<T> rhs) {
 template <typename T, typename Alloc>
 void vector<T, Alloc>::push_back(const T& value) {
     if (finish != end_of_storage)
-        construct(finish++, value);
+        mystl::construct(finish++, value);
     else
         insert_aux(finish, value);
 }
@@ -213,7 +213,7 @@ template<typename T, typename Alloc>
 typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(iterator pos, const T& value) {
     size_type n = pos - start;
     if (finish != end_of_storage && pos == finish)
-        construct(finish++, value);
+        mystl::construct(finish++, value);
     else insert_aux(pos, value);
     return start + n;
 }
@@ -224,13 +224,13 @@ void vector<T, Alloc>::insert(iterator pos, size_type n, const T& value) {
     if (size() + n < capacity()) {
         const size_type elems_after = finish - pos;
         if (elems_after > n) {
-            uninitialized_copy(finish - n, finish, finish);
+            mystl::uninitialized_copy(finish - n, finish, finish);
             std::copy_backward(pos, finish - n, finish);
             std::fill(pos, pos + n, value);
         }
         else {
-            uninitialized_fill_n(finish, n - elems_after, value);
-            uninitialized_copy(pos, finish, pos + n);
+            mystl::uninitialized_fill_n(finish, n - elems_after, value);
+            mystl::uninitialized_copy(pos, finish, pos + n);
             std::fill(pos, finish, value);
         }
         finish += n;
@@ -241,16 +241,16 @@ void vector<T, Alloc>::insert(iterator pos, size_type n, const T& value) {
         iterator new_start = Alloc::allocate(new_size);
         iterator new_finish = new_start;
         try {
-            new_finish = uninitialized_copy(start, pos, new_start);
-            new_finish = uninitialized_fill_n(new_finish, n, value);
-            new_finish = uninitialized_copy(pos, finish, new_finish);
+            new_finish = mystl::uninitialized_copy(start, pos, new_start);
+            new_finish = mystl::uninitialized_fill_n(new_finish, n, value);
+            new_finish = mystl::uninitialized_copy(pos, finish, new_finish);
         }
         catch(...) {
-            destroy(new_start, new_finish);
+            mystl::destroy(new_start, new_finish);
             Alloc::deallocate(new_start, new_size);
             throw;
         }
-        destroy(start, finish);
+        mystl::destroy(start, finish);
         deallocate();
         start = new_start;
         finish = new_finish;
@@ -262,7 +262,7 @@ template <typename T, typename Alloc>
 typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(iterator pos) {
     if (pos != (finish - 1))
         std::copy(pos + 1, finish, pos);
-    destroy(finish - 1);
+    mystl::destroy(finish - 1);
     --finish;
     return pos;
 }
@@ -270,7 +270,7 @@ typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(iterator pos) {
 template <typename T, typename Alloc>
 typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(iterator first, iterator last) {
     iterator new_finish = std::copy(last, finish, first);
-    destroy(new_finish, finish);
+    mystl::destroy(new_finish, finish);
     finish = new_finish;
     return first;
 }
@@ -289,13 +289,13 @@ void vector<T, Alloc>::reserve(size_type n) {
         iterator new_start = Alloc::allocate(n);
         iterator new_finish = new_start;
         try{
-        new_finish = uninitialized_copy(start, finish, new_start);
+        new_finish = mystl::uninitialized_copy(start, finish, new_start);
         }
         catch(...) {
-            destroy(new_start, new_finish);
+            mystl::destroy(new_start, new_finish);
             Alloc::deallocate(new_start, n);
         }
-        destroy(start, finish);
+        mystl::destroy(start, finish);
         deallocate();
         start = new_start;
         finish = new_finish;